@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_chain.h"
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "text_layout.h"
+#include "text_renderer.h"
+
+/*
+ * 多字体回退链
+ *
+ * 拉丁、中文和符号混排的字符串由一串按优先级排列的字体共同绘制：每个码点
+ * 使用第一个包含它的字体，查找结果缓存在 FontChain 中。所有字体的字形都放在
+ * 同一个图集里，因此三行混排文本仍然只需要一次 draw call。
+ */
+
+/* Window dimensions */
+const GLuint WIDTH = 800, HEIGHT = 600;
+
+#define ATLAS_SIZE 1024
+
+/* Fallback order: Latin first, then CJK, then symbols */
+const char *fontFamilies[] = {
+    "Arial", "FreeSans", "DejaVu Sans", "Helvetica",
+    "Noto Sans CJK SC", "Droid Sans Fallback", "WenQuanYi Micro Hei",
+    "Microsoft YaHei", "PingFang SC", "Noto Sans SC",
+    "Noto Sans Symbols", "Noto Sans Symbols2", "Symbola", "Segoe UI Symbol"};
+
+const char *lines[] = {
+    "Hello, 世界! Привет, мир!",
+    "价格 Price: ¥128 / €16 / $18",
+    "Mixed ★ ∑ → ♫ 你好 World"};
+
+FontRegistry fonts;
+FontChain chain;
+GlyphAtlas atlas;
+TextRenderer textRenderer;
+GLuint VAO;
+
+/* Function prototypes */
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+void initFontChain(FT_Library ft);
+
+int main(void)
+{
+    /* Initialize GLFW */
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return -1;
+    }
+
+    /* Set OpenGL version and profile */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    /* Create a windowed mode window and its OpenGL context */
+    GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Font Fallback", NULL, NULL);
+    if (!window)
+    {
+        fprintf(stderr, "Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    /* Set callback functions */
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+
+    /* Initialize GLEW */
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        return -1;
+    }
+    initFontChain(ft);
+
+    /* Rasterize every line through the chain into one atlas */
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        return -1;
+    int numLines = sizeof(lines) / sizeof(lines[0]);
+    for (int i = 0; i < numLines; i++)
+        fontChainRasterizeString(&chain, &atlas, lines[i]);
+
+    /* All glyphs are in the atlas now, the faces are no longer needed */
+    for (int i = 0; i < chain.Count; i++)
+        FT_Done_Face(chain.Faces[i]);
+    fontChainDestroy(&chain);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+
+    textRendererInit(&textRenderer, &atlas);
+    VAO = textRendererCreateVAO(&textRenderer);
+    textRendererSetViewport(&textRenderer, (float)WIDTH, (float)HEIGHT);
+
+    /* Enable blending for text rendering */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    DrawList list;
+    drawListInit(&list);
+
+    /* Main loop */
+    while (!glfwWindowShouldClose(window))
+    {
+        /* Clear the screen */
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        /* 三行混排文本放进同一个 DrawList，一次提交 */
+        float scale = 0.75f;
+        float y = HEIGHT / 2.0f;
+        drawListClear(&list);
+        for (int i = 0; i < numLines; i++)
+        {
+            float x = (WIDTH - measureText(&atlas, lines[i], scale)) / 2.0f;
+            float r = i == 1 ? -1 : (i == 0 ? 0 : 255);
+            float g = i == 1 ? -1 : (i == 0 ? 0 : 215);
+            float b = i == 1 ? -1 : 0;
+            layoutText(&list, &atlas, lines[i], x, y + (i - 1) * 100, scale, r, g, b);
+        }
+        textRendererSubmit(&textRenderer, VAO, &list);
+
+        /* Swap front and back buffers */
+        glfwSwapBuffers(window);
+
+        /* Poll for and process events */
+        glfwPollEvents();
+    }
+
+    /* Clean up */
+    drawListFree(&list);
+    glDeleteVertexArrays(1, &VAO);
+    textRendererDestroy(&textRenderer);
+    glyphAtlasDestroy(&atlas);
+
+    /* Terminate GLFW */
+    glfwTerminate();
+
+    return 0;
+}
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GL_TRUE);
+}
+
+void initFontChain(FT_Library ft)
+{
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+    if (!fontChainInit(&chain))
+        exit(1);
+
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    for (int i = 0; i < numFamilies; i++)
+    {
+        const FontEntry *font = fontRegistryFindUpright(&fonts, fontFamilies[i]);
+        FT_Face face;
+        if (!font || !fontRegistryOpenFace(&fonts, ft, font, &face))
+            continue;
+
+        /* Bitmap-only faces without a 48px strike cannot join the chain */
+        if (FT_Set_Pixel_Sizes(face, 0, 48) != 0 || !fontChainAdd(&chain, face))
+        {
+            FT_Done_Face(face);
+            continue;
+        }
+        printf("Fallback #%d: %s (%s %s)\n", chain.Count, font->Path, font->Family, font->Style);
+    }
+
+    if (chain.Count == 0)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        exit(1);
+    }
+}
@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include <string.h>
+#include "font_chain.h"
+#include "utf8.h"
+
+#define UNICODE_LIMIT 0x110000
+#define CHAIN_PAGE_COUNT (UNICODE_LIMIT >> 8)
+#define CHAIN_MISSING 0xFF
+
+int fontChainInit(FontChain *chain)
+{
+    memset(chain, 0, sizeof(*chain));
+    chain->Pages = (unsigned char **)calloc(CHAIN_PAGE_COUNT, sizeof(unsigned char *));
+    return chain->Pages != NULL;
+}
+
+void fontChainDestroy(FontChain *chain)
+{
+    if (chain->Pages)
+    {
+        for (int i = 0; i < CHAIN_PAGE_COUNT; i++)
+            free(chain->Pages[i]);
+        free(chain->Pages);
+    }
+    memset(chain, 0, sizeof(*chain));
+}
+
+int fontChainAdd(FontChain *chain, FT_Face face)
+{
+    if (chain->Count == FONT_CHAIN_MAX)
+        return 0;
+
+    chain->Faces[chain->Count++] = face;
+
+    /* Code points nobody covered so far may be covered by the new face */
+    for (int i = 0; i < CHAIN_PAGE_COUNT; i++)
+    {
+        unsigned char *page = chain->Pages[i];
+        for (int j = 0; page && j < 256; j++)
+        {
+            if (page[j] == CHAIN_MISSING)
+                page[j] = 0;
+        }
+    }
+
+    return 1;
+}
+
+int fontChainResolve(FontChain *chain, unsigned int codepoint)
+{
+    if (codepoint >= UNICODE_LIMIT)
+        return -1;
+
+    unsigned char *page = chain->Pages[codepoint >> 8];
+    if (page && page[codepoint & 0xFF])
+        return page[codepoint & 0xFF] == CHAIN_MISSING ? -1 : page[codepoint & 0xFF] - 1;
+
+    /* First time: walk the chain in priority order */
+    if (!page)
+    {
+        page = (unsigned char *)calloc(256, 1);
+        if (!page)
+            return -1;
+        chain->Pages[codepoint >> 8] = page;
+    }
+
+    int found = -1;
+    for (int i = 0; i < chain->Count; i++)
+    {
+        if (FT_Get_Char_Index(chain->Faces[i], codepoint) != 0)
+        {
+            found = i;
+            break;
+        }
+    }
+
+    page[codepoint & 0xFF] = found < 0 ? CHAIN_MISSING : (unsigned char)(found + 1);
+    return found;
+}
+
+const AtlasGlyph *fontChainRasterize(FontChain *chain, GlyphAtlas *atlas, unsigned int codepoint)
+{
+    const AtlasGlyph *existing = glyphAtlasFind(atlas, codepoint);
+    if (existing || chain->Count == 0)
+        return existing;
+
+    int index = fontChainResolve(chain, codepoint);
+    return glyphAtlasAdd(atlas, chain->Faces[index < 0 ? 0 : index], codepoint);
+}
+
+int fontChainRasterizeString(FontChain *chain, GlyphAtlas *atlas, const char *text)
+{
+    int failures = 0;
+    const char *p = text;
+
+    while (*p)
+    {
+        if (!fontChainRasterize(chain, atlas, codepoint_from_utf8(&p)))
+            failures++;
+    }
+
+    return failures;
+}
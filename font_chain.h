@@ -0,0 +1,50 @@
+#ifndef FONT_CHAIN_H
+#define FONT_CHAIN_H
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "glyph_atlas.h"
+
+/*
+ * Ordered fallback chain of faces.
+ *
+ * A code point is drawn with the first face that maps it (FT_Get_Char_Index
+ * != 0).  The answer is memoized in a two-level table: one lazily allocated
+ * 256-byte page per 256 code points, so after the first hit resolving a code
+ * point is a single table lookup and only pages that are actually used cost
+ * memory.  Glyphs from every face go into the same GlyphAtlas, so a mixed
+ * Latin/CJK/symbol string is still one batch.
+ */
+
+#define FONT_CHAIN_MAX 16
+
+typedef struct
+{
+    FT_Face Faces[FONT_CHAIN_MAX];
+    int Count;
+
+    /* Code point -> 0 unresolved, 0xFF missing, otherwise face index + 1 */
+    unsigned char **Pages;
+} FontChain;
+
+int fontChainInit(FontChain *chain);
+
+/* Does not free the faces, they belong to the caller */
+void fontChainDestroy(FontChain *chain);
+
+/* Append a face at the lowest priority so far, returns 0 if the chain is full */
+int fontChainAdd(FontChain *chain, FT_Face face);
+
+/* Index of the first face covering codepoint, -1 if none does */
+int fontChainResolve(FontChain *chain, unsigned int codepoint);
+
+/*
+ * Rasterize codepoint with the face that covers it.  Code points no face
+ * covers get the primary face's .notdef box.
+ */
+const AtlasGlyph *fontChainRasterize(FontChain *chain, GlyphAtlas *atlas, unsigned int codepoint);
+
+/* Rasterize every code point of a UTF-8 string, returns number of failures */
+int fontChainRasterizeString(FontChain *chain, GlyphAtlas *atlas, const char *text);
+
+#endif /* FONT_CHAIN_H */
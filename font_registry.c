@@ -0,0 +1,533 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "font_registry.h"
+
+#define CACHE_HEADER "# font-registry v1"
+#define MAX_SCAN_DEPTH 8
+
+/* Default font directories, missing ones cost a single failed opendir() */
+static const char *defaultFontDirs[] = {
+    "fonts",                       /* Project directory */
+    "/usr/share/fonts",            /* Linux */
+    "/usr/local/share/fonts",      /* Linux local */
+    "/System/Library/Fonts",       /* macOS */
+    "/Library/Fonts",              /* macOS alternative */
+    "/mnt/c/Windows/Fonts"         /* Windows wsl */
+};
+
+static char *copyString(const char *s)
+{
+    size_t n = strlen(s) + 1;
+    char *copy = (char *)malloc(n);
+    if (copy)
+        memcpy(copy, s, n);
+    return copy;
+}
+
+static void copyName(char *dst, const char *src)
+{
+    /* Tabs and newlines would break the cache format */
+    int i = 0;
+    for (; src && src[i] && i < FONT_NAME_MAX - 1; i++)
+        dst[i] = (src[i] == '\t' || src[i] == '\n') ? ' ' : src[i];
+    dst[i] = '\0';
+}
+
+static FontEntry *appendEntry(FontRegistry *registry)
+{
+    if (registry->Count == registry->Capacity)
+    {
+        int capacity = registry->Capacity ? registry->Capacity * 2 : 64;
+        FontEntry *entries = (FontEntry *)realloc(registry->Entries, capacity * sizeof(FontEntry));
+        if (!entries)
+            return NULL;
+        registry->Entries = entries;
+        registry->Capacity = capacity;
+    }
+
+    FontEntry *entry = &registry->Entries[registry->Count++];
+    memset(entry, 0, sizeof(*entry));
+    return entry;
+}
+
+static int compareEntries(const void *a, const void *b)
+{
+    const FontEntry *x = (const FontEntry *)a;
+    const FontEntry *y = (const FontEntry *)b;
+    int c = strcmp(x->Path, y->Path);
+    return c ? c : x->FaceIndex - y->FaceIndex;
+}
+
+static int isFontFile(const char *name)
+{
+    const char *ext = strrchr(name, '.');
+    return ext && (strcasecmp(ext, ".ttf") == 0 || strcasecmp(ext, ".otf") == 0 ||
+                   strcasecmp(ext, ".ttc") == 0 || strcasecmp(ext, ".otc") == 0);
+}
+
+/* ---- Cache file ---- */
+
+static void loadCache(FontRegistry *cache, const char *cachePath)
+{
+    FILE *file = fopen(cachePath, "r");
+    if (!file)
+        return;
+
+    char line[4096];
+    if (!fgets(line, sizeof(line), file) || strncmp(line, CACHE_HEADER, strlen(CACHE_HEADER)) != 0)
+    {
+        fclose(file);
+        return;
+    }
+
+    /* mtime \t size \t index \t path \t family \t style \t coverage(hex) */
+    while (fgets(line, sizeof(line), file))
+    {
+        char *fields[7];
+        char *p = line;
+        int n = 0;
+        for (; n < 7 && p; n++)
+        {
+            fields[n] = p;
+            p = strchr(p, n < 6 ? '\t' : '\n');
+            if (p)
+                *p++ = '\0';
+        }
+        if (n < 7 || strlen(fields[6]) != FONT_COVERAGE_BYTES * 2)
+            continue;
+
+        FontEntry *entry = appendEntry(cache);
+        if (!entry)
+            break;
+        entry->Mtime = strtoll(fields[0], NULL, 10);
+        entry->Size = strtoll(fields[1], NULL, 10);
+        entry->FaceIndex = atoi(fields[2]);
+        entry->Path = copyString(fields[3]);
+        copyName(entry->Family, fields[4]);
+        copyName(entry->Style, fields[5]);
+        for (int i = 0; i < FONT_COVERAGE_BYTES; i++)
+        {
+            unsigned int byte;
+            sscanf(fields[6] + 2 * i, "%2x", &byte);
+            entry->Coverage[i] = (unsigned char)byte;
+        }
+    }
+
+    fclose(file);
+    qsort(cache->Entries, cache->Count, sizeof(FontEntry), compareEntries);
+}
+
+/* Create every missing directory leading up to path, like mkdir -p */
+static int makeParentDirs(const char *path)
+{
+    char dir[4096];
+    snprintf(dir, sizeof(dir), "%s", path);
+
+    for (char *p = dir + 1; *p; p++)
+    {
+        if (*p != '/')
+            continue;
+        *p = '\0';
+        if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+            return 0;
+        *p = '/';
+    }
+    return 1;
+}
+
+static void saveCache(const FontRegistry *registry, const char *cachePath)
+{
+    /* Write to a unique temporary file next to the cache and rename it, readers
+     * never see half a cache and concurrent writers do not share a file */
+    char tmpPath[4096];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.XXXXXX", cachePath);
+
+    if (!makeParentDirs(cachePath))
+    {
+        fprintf(stderr, "ERROR::FONTREGISTRY: Cannot create directory for %s\n", cachePath);
+        return;
+    }
+
+    int fd = mkstemp(tmpPath);
+    if (fd < 0)
+        return;
+    fchmod(fd, 0644);
+
+    FILE *file = fdopen(fd, "w");
+    if (!file)
+    {
+        close(fd);
+        remove(tmpPath);
+        return;
+    }
+
+    fprintf(file, "%s\n", CACHE_HEADER);
+    for (int i = 0; i < registry->Count + registry->Unreadable; i++)
+    {
+        const FontEntry *e = &registry->Entries[i];
+        fprintf(file, "%lld\t%lld\t%d\t%s\t%s\t%s\t", e->Mtime, e->Size, e->FaceIndex,
+                e->Path, e->Family, e->Style);
+        for (int j = 0; j < FONT_COVERAGE_BYTES; j++)
+            fprintf(file, "%02x", e->Coverage[j]);
+        fputc('\n', file);
+    }
+
+    if (fclose(file) == 0)
+        rename(tmpPath, cachePath);
+    else
+        remove(tmpPath);
+}
+
+static void defaultCachePath(char *buffer, size_t size)
+{
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+
+    if (xdg && *xdg)
+        snprintf(buffer, size, "%s/opengl-learning-fonts.cache", xdg);
+    else if (home && *home)
+        snprintf(buffer, size, "%s/.cache/opengl-learning-fonts.cache", home);
+    else
+        snprintf(buffer, size, "fonts.cache");
+}
+
+/* ---- Scanning ---- */
+
+typedef struct
+{
+    FontRegistry *Registry;
+    const FontRegistry *Cache;
+    FT_Library Ft;
+    int Parsed; /* Files that had to be opened with FreeType */
+} ScanState;
+
+static void computeCoverage(FT_Face face, unsigned char *coverage)
+{
+    FT_UInt index;
+    FT_ULong charcode = FT_Get_First_Char(face, &index);
+
+    memset(coverage, 0, FONT_COVERAGE_BYTES);
+    while (index != 0)
+    {
+        FT_ULong page = charcode >> 8;
+        if (page >= FONT_COVERAGE_PAGES)
+            break;
+        coverage[page >> 3] |= (unsigned char)(1u << (page & 7));
+
+        /* Skip to the next page, one bit is enough per page */
+        charcode = FT_Get_Next_Char(face, (page + 1) * 256 - 1, &index);
+    }
+}
+
+static void parseFontFile(ScanState *state, const char *path, const struct stat *st)
+{
+    FT_Face face;
+    FT_Long numFaces = 1;
+
+    state->Parsed++;
+    for (FT_Long i = 0; i < numFaces; i++)
+    {
+        if (FT_New_Face(state->Ft, path, i, &face) != 0)
+        {
+            /* Remember files FreeType cannot read, they are skipped by mtime next time */
+            FontEntry *entry = i == 0 ? appendEntry(state->Registry) : NULL;
+            if (entry)
+            {
+                entry->Path = copyString(path);
+                entry->FaceIndex = -1;
+                entry->Mtime = (long long)st->st_mtime;
+                entry->Size = (long long)st->st_size;
+            }
+            break;
+        }
+        numFaces = face->num_faces;
+
+        FontEntry *entry = appendEntry(state->Registry);
+        if (entry)
+        {
+            entry->Path = copyString(path);
+            entry->FaceIndex = (int)i;
+            entry->Mtime = (long long)st->st_mtime;
+            entry->Size = (long long)st->st_size;
+            copyName(entry->Family, face->family_name);
+            copyName(entry->Style, face->style_name);
+            computeCoverage(face, entry->Coverage);
+        }
+
+        FT_Done_Face(face);
+    }
+}
+
+static void addFontFile(ScanState *state, const char *path, const struct stat *st)
+{
+    const FontRegistry *cache = state->Cache;
+    FontEntry key;
+    key.Path = (char *)path;
+
+    /* Reuse every cached face of this file if mtime and size still match */
+    const FontEntry *hit = NULL;
+    for (key.FaceIndex = 0; key.FaceIndex >= -1 && !hit && cache->Count; key.FaceIndex--)
+        hit = (const FontEntry *)bsearch(&key, cache->Entries, cache->Count, sizeof(FontEntry), compareEntries);
+    if (hit && hit->Mtime == (long long)st->st_mtime && hit->Size == (long long)st->st_size)
+    {
+        for (const FontEntry *e = hit; e < cache->Entries + cache->Count && strcmp(e->Path, path) == 0; e++)
+        {
+            FontEntry *entry = appendEntry(state->Registry);
+            if (!entry)
+                return;
+            *entry = *e;
+            entry->Path = copyString(path);
+        }
+        return;
+    }
+
+    parseFontFile(state, path, st);
+}
+
+static void scanDirectory(ScanState *state, const char *dir, int depth)
+{
+    DIR *d = opendir(dir);
+    if (!d)
+        return;
+
+    struct dirent *ent;
+    char path[4096];
+    struct stat st;
+
+    while ((ent = readdir(d)) != NULL)
+    {
+        if (ent->d_name[0] == '.')
+            continue;
+
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        if (strchr(path, '\t') || strchr(path, '\n') || stat(path, &st) != 0)
+            continue;
+
+        if (S_ISDIR(st.st_mode))
+        {
+            if (depth < MAX_SCAN_DEPTH)
+                scanDirectory(state, path, depth + 1);
+        }
+        else if (S_ISREG(st.st_mode) && isFontFile(ent->d_name))
+        {
+            addFontFile(state, path, &st);
+        }
+    }
+
+    closedir(d);
+}
+
+static void freeEntries(FontRegistry *registry)
+{
+    for (int i = 0; i < registry->Count + registry->Unreadable; i++)
+        free(registry->Entries[i].Path);
+    free(registry->Entries);
+    registry->Entries = NULL;
+    registry->Count = registry->Capacity = registry->Unreadable = 0;
+}
+
+/* Move the entries of unreadable files behind the faces, keeping the order */
+static void partitionUnreadable(FontRegistry *registry)
+{
+    int faces = 0;
+    for (int i = 0; i < registry->Count; i++)
+    {
+        if (registry->Entries[i].FaceIndex < 0)
+            continue;
+        FontEntry entry = registry->Entries[i];
+        memmove(&registry->Entries[faces + 1], &registry->Entries[faces], (i - faces) * sizeof(FontEntry));
+        registry->Entries[faces++] = entry;
+    }
+    registry->Unreadable = registry->Count - faces;
+    registry->Count = faces;
+}
+
+int fontRegistryLoad(FontRegistry *registry, const char *cachePath,
+                     const char *const *dirs, int numDirs)
+{
+    char defaultPath[4096];
+    memset(registry, 0, sizeof(*registry));
+
+    if (!cachePath)
+    {
+        defaultCachePath(defaultPath, sizeof(defaultPath));
+        cachePath = defaultPath;
+    }
+    if (!dirs)
+    {
+        dirs = defaultFontDirs;
+        numDirs = sizeof(defaultFontDirs) / sizeof(defaultFontDirs[0]);
+    }
+
+    FontRegistry cache;
+    memset(&cache, 0, sizeof(cache));
+    loadCache(&cache, cachePath);
+
+    ScanState state = {registry, &cache, NULL, 0};
+    if (FT_Init_FreeType(&state.Ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        freeEntries(&cache);
+        return 0;
+    }
+
+    for (int i = 0; i < numDirs; i++)
+        scanDirectory(&state, dirs[i], 0);
+
+    FT_Done_FreeType(state.Ft);
+
+    qsort(registry->Entries, registry->Count, sizeof(FontEntry), compareEntries);
+    partitionUnreadable(registry);
+
+    /* Rewrite the cache if a file was parsed or a cached file disappeared */
+    if (state.Parsed > 0 || registry->Count + registry->Unreadable != cache.Count)
+        saveCache(registry, cachePath);
+
+    freeEntries(&cache);
+    return registry->Count;
+}
+
+void fontRegistryDestroy(FontRegistry *registry)
+{
+    freeEntries(registry);
+
+    for (int i = 0; i < registry->MappingCount; i++)
+    {
+        munmap(registry->Mappings[i].Data, registry->Mappings[i].Size);
+        free(registry->Mappings[i].Path);
+    }
+    free(registry->Mappings);
+    memset(registry, 0, sizeof(*registry));
+}
+
+const FontEntry *fontRegistryFind(const FontRegistry *registry, const char *family, const char *style)
+{
+    const FontEntry *match = NULL;
+
+    for (int i = 0; i < registry->Count; i++)
+    {
+        const FontEntry *entry = &registry->Entries[i];
+        if (strcasecmp(entry->Family, family) != 0)
+            continue;
+        if (!style || strcasecmp(entry->Style, style) == 0)
+            return entry;
+        if (!match)
+            match = entry;
+    }
+
+    return match;
+}
+
+const FontEntry *fontRegistryFindUpright(const FontRegistry *registry, const char *family)
+{
+    /* Fonts name their upright weight differently, e.g. DejaVu Sans uses "Book" */
+    const char *uprightStyles[] = {"Regular", "Book", "Normal", "Roman", "Medium"};
+    int numStyles = sizeof(uprightStyles) / sizeof(uprightStyles[0]);
+
+    for (int i = 0; i < numStyles; i++)
+    {
+        const FontEntry *entry = fontRegistryFind(registry, family, uprightStyles[i]);
+        if (entry && strcasecmp(entry->Style, uprightStyles[i]) == 0)
+            return entry;
+    }
+
+    return fontRegistryFind(registry, family, NULL);
+}
+
+int fontEntryMayCover(const FontEntry *entry, unsigned int codepoint)
+{
+    unsigned int page = codepoint >> 8;
+    if (page >= FONT_COVERAGE_PAGES)
+        return 1; /* Not tracked, let FT_Get_Char_Index decide */
+    return (entry->Coverage[page >> 3] >> (page & 7)) & 1;
+}
+
+/* Map a file once, later faces from the same file reuse the mapping */
+static const FontMapping *mapFontFile(FontRegistry *registry, const char *path)
+{
+    for (int i = 0; i < registry->MappingCount; i++)
+    {
+        if (strcmp(registry->Mappings[i].Path, path) == 0)
+            return &registry->Mappings[i];
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); /* The mapping keeps the file referenced */
+    if (data == MAP_FAILED)
+        return NULL;
+
+    if (registry->MappingCount == registry->MappingCapacity)
+    {
+        int capacity = registry->MappingCapacity ? registry->MappingCapacity * 2 : 8;
+        FontMapping *mappings = (FontMapping *)realloc(registry->Mappings, capacity * sizeof(FontMapping));
+        if (!mappings)
+        {
+            munmap(data, (size_t)st.st_size);
+            return NULL;
+        }
+        registry->Mappings = mappings;
+        registry->MappingCapacity = capacity;
+    }
+
+    FontMapping *mapping = &registry->Mappings[registry->MappingCount++];
+    mapping->Path = copyString(path);
+    mapping->Data = data;
+    mapping->Size = (size_t)st.st_size;
+    return mapping;
+}
+
+int fontRegistryOpenFace(FontRegistry *registry, FT_Library ft, const FontEntry *entry, FT_Face *face)
+{
+    const FontMapping *mapping = mapFontFile(registry, entry->Path);
+    if (!mapping)
+        return 0;
+
+    return FT_New_Memory_Face(ft, (const FT_Byte *)mapping->Data, (FT_Long)mapping->Size,
+                              entry->FaceIndex, face) == 0;
+}
+
+const FontEntry *fontRegistryOpenPreferred(FontRegistry *registry, FT_Library ft,
+                                           const char *const *families, int numFamilies,
+                                           unsigned int codepoint, FT_Face *face)
+{
+    for (int i = 0; i < numFamilies; i++)
+    {
+        const FontEntry *entry = fontRegistryFindUpright(registry, families[i]);
+        if (entry && fontRegistryOpenFace(registry, ft, entry, face))
+            return entry;
+    }
+
+    /* None of the preferred families is installed, take anything that fits */
+    for (int i = 0; i < registry->Count; i++)
+    {
+        const FontEntry *entry = &registry->Entries[i];
+        if (!fontEntryMayCover(entry, codepoint) || !fontRegistryOpenFace(registry, ft, entry, face))
+            continue;
+        if (FT_Get_Char_Index(*face, codepoint) != 0)
+            return entry;
+        FT_Done_Face(*face);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,88 @@
+#ifndef FONT_REGISTRY_H
+#define FONT_REGISTRY_H
+
+#include <stddef.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+/*
+ * Indexed font registry.
+ *
+ * The configured directories are scanned once and every face found (each
+ * face of a .ttc collection counts separately) is described by family,
+ * style, a coarse coverage bitmap, path and face index.  The index is cached
+ * on disk; on the next start a file is only parsed again if its mtime or
+ * size changed, so startup costs one stat() per font file instead of one
+ * FT_New_Face() per candidate path.
+ *
+ * Faces are opened with FT_New_Memory_Face() over a read-only mmap() of the
+ * file.  Mappings are shared by every face opened from the same file and
+ * stay valid until fontRegistryDestroy(), so faces (also from other
+ * FT_Library instances on other threads) must be closed before that.
+ */
+
+#define FONT_NAME_MAX 64
+
+/* One coverage bit per 256 code points, up to U+2FFFF (BMP, SMP, SIP) */
+#define FONT_COVERAGE_PAGES 0x300
+#define FONT_COVERAGE_BYTES (FONT_COVERAGE_PAGES / 8)
+
+typedef struct
+{
+    char *Path;
+    int FaceIndex;
+    char Family[FONT_NAME_MAX];
+    char Style[FONT_NAME_MAX];
+    long long Mtime;
+    long long Size;
+    unsigned char Coverage[FONT_COVERAGE_BYTES];
+} FontEntry;
+
+typedef struct
+{
+    char *Path;
+    void *Data;
+    size_t Size;
+} FontMapping;
+
+typedef struct
+{
+    FontEntry *Entries;
+    int Count;      /* Faces */
+    int Capacity;
+    int Unreadable; /* Entries[Count..] are files FreeType failed to parse (FaceIndex -1) */
+
+    FontMapping *Mappings;
+    int MappingCount;
+    int MappingCapacity;
+} FontRegistry;
+
+/*
+ * Scan dirs (NULL: platform defaults) using the cache at cachePath (NULL:
+ * default location).  Returns the number of faces known.
+ */
+int fontRegistryLoad(FontRegistry *registry, const char *cachePath,
+                     const char *const *dirs, int numDirs);
+void fontRegistryDestroy(FontRegistry *registry);
+
+/* First face with the given family (case-insensitive), preferring style */
+const FontEntry *fontRegistryFind(const FontRegistry *registry, const char *family, const char *style);
+
+/* The family's upright face ("Regular", "Book", ...), otherwise its first face */
+const FontEntry *fontRegistryFindUpright(const FontRegistry *registry, const char *family);
+
+/* Coverage bitmap test; a hit only means the face has code points in that page */
+int fontEntryMayCover(const FontEntry *entry, unsigned int codepoint);
+
+/* Open a face from a memory mapping of the entry's file */
+int fontRegistryOpenFace(FontRegistry *registry, FT_Library ft, const FontEntry *entry, FT_Face *face);
+
+/*
+ * Open the first installed family of families[], otherwise any face that maps
+ * codepoint.  Returns the entry that was opened or NULL.
+ */
+const FontEntry *fontRegistryOpenPreferred(FontRegistry *registry, FT_Library ft,
+                                           const char *const *families, int numFamilies,
+                                           unsigned int codepoint, FT_Face *face);
+
+#endif /* FONT_REGISTRY_H */
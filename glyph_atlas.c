@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "glyph_atlas.h"
+#include "utf8.h"
+
+/* Empty pixels between neighbouring glyphs so linear filtering does not bleed */
+#define ATLAS_PADDING 1
+
+static unsigned int hashCodepoint(unsigned int codepoint)
+{
+    /* Knuth multiplicative hash */
+    return codepoint * 2654435761u;
+}
+
+int glyphAtlasCreate(GlyphAtlas *atlas, int width, int height)
+{
+    memset(atlas, 0, sizeof(*atlas));
+
+    atlas->Pixels = (unsigned char *)calloc((size_t)width * height, 1);
+    atlas->Capacity = 256;
+    atlas->Glyphs = (AtlasGlyph *)calloc(atlas->Capacity, sizeof(AtlasGlyph));
+    if (!atlas->Pixels || !atlas->Glyphs)
+    {
+        fprintf(stderr, "ERROR::ATLAS: Failed to allocate %dx%d atlas\n", width, height);
+        glyphAtlasDestroy(atlas);
+        return 0;
+    }
+
+    atlas->Width = width;
+    atlas->Height = height;
+    atlas->PenX = ATLAS_PADDING;
+    atlas->PenY = ATLAS_PADDING;
+    glyphAtlasClearDirty(atlas);
+    return 1;
+}
+
+void glyphAtlasDestroy(GlyphAtlas *atlas)
+{
+    free(atlas->Pixels);
+    free(atlas->Glyphs);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+static AtlasGlyph *findSlot(AtlasGlyph *glyphs, int capacity, unsigned int codepoint)
+{
+    unsigned int mask = (unsigned int)capacity - 1;
+    unsigned int i = hashCodepoint(codepoint) & mask;
+
+    while (glyphs[i].Used && glyphs[i].Codepoint != codepoint)
+        i = (i + 1) & mask;
+
+    return &glyphs[i];
+}
+
+const AtlasGlyph *glyphAtlasFind(const GlyphAtlas *atlas, unsigned int codepoint)
+{
+    const AtlasGlyph *slot = findSlot(atlas->Glyphs, atlas->Capacity, codepoint);
+    return slot->Used && !slot->Missing ? slot : NULL;
+}
+
+static int growTable(GlyphAtlas *atlas)
+{
+    int capacity = atlas->Capacity * 2;
+    AtlasGlyph *glyphs = (AtlasGlyph *)calloc(capacity, sizeof(AtlasGlyph));
+    if (!glyphs)
+        return 0;
+
+    for (int i = 0; i < atlas->Capacity; i++)
+    {
+        if (atlas->Glyphs[i].Used)
+            *findSlot(glyphs, capacity, atlas->Glyphs[i].Codepoint) = atlas->Glyphs[i];
+    }
+
+    free(atlas->Glyphs);
+    atlas->Glyphs = glyphs;
+    atlas->Capacity = capacity;
+    return 1;
+}
+
+/* Reserve a width x height rectangle, returns 0 when the atlas is full */
+static int packRect(GlyphAtlas *atlas, int width, int height, int *x, int *y)
+{
+    if (atlas->PenX + width + ATLAS_PADDING > atlas->Width)
+    {
+        /* Start a new shelf */
+        atlas->PenX = ATLAS_PADDING;
+        atlas->PenY += atlas->RowHeight + ATLAS_PADDING;
+        atlas->RowHeight = 0;
+    }
+
+    if (atlas->PenX + width + ATLAS_PADDING > atlas->Width ||
+        atlas->PenY + height + ATLAS_PADDING > atlas->Height)
+        return 0;
+
+    *x = atlas->PenX;
+    *y = atlas->PenY;
+    atlas->PenX += width + ATLAS_PADDING;
+    if (height > atlas->RowHeight)
+        atlas->RowHeight = height;
+    return 1;
+}
+
+/* Remember a code point that could not be added, so it is not retried */
+static void addMissing(GlyphAtlas *atlas, unsigned int codepoint)
+{
+    AtlasGlyph *glyph = findSlot(atlas->Glyphs, atlas->Capacity, codepoint);
+    memset(glyph, 0, sizeof(*glyph));
+    glyph->Codepoint = codepoint;
+    glyph->Used = 1;
+    glyph->Missing = 1;
+    atlas->Count++;
+}
+
+const AtlasGlyph *glyphAtlasAdd(GlyphAtlas *atlas, FT_Face face, unsigned int codepoint)
+{
+    const AtlasGlyph *existing = findSlot(atlas->Glyphs, atlas->Capacity, codepoint);
+    if (existing->Used)
+        return existing->Missing ? NULL : existing;
+
+    /* Keep load factor below 1/2 */
+    if ((atlas->Count + 1) * 2 > atlas->Capacity && !growTable(atlas))
+        return NULL;
+
+    if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load Glyph (Unicode %u)\n", codepoint);
+        addMissing(atlas, codepoint);
+        return NULL;
+    }
+
+    FT_Bitmap *bitmap = &face->glyph->bitmap;
+    int width = (int)bitmap->width;
+    int height = (int)bitmap->rows;
+    int x = 0, y = 0;
+
+    if (width > 0 && height > 0)
+    {
+        if (!packRect(atlas, width, height, &x, &y))
+        {
+            fprintf(stderr, "ERROR::ATLAS: Atlas full, cannot add Unicode %u\n", codepoint);
+            addMissing(atlas, codepoint);
+            return NULL;
+        }
+
+        /* Copy bitmap rows, pitch may be larger than width */
+        for (int row = 0; row < height; row++)
+        {
+            memcpy(atlas->Pixels + (size_t)(y + row) * atlas->Width + x,
+                   bitmap->buffer + (size_t)row * bitmap->pitch,
+                   width);
+        }
+
+        if (x < atlas->DirtyX0)
+            atlas->DirtyX0 = x;
+        if (y < atlas->DirtyY0)
+            atlas->DirtyY0 = y;
+        if (x + width > atlas->DirtyX1)
+            atlas->DirtyX1 = x + width;
+        if (y + height > atlas->DirtyY1)
+            atlas->DirtyY1 = y + height;
+    }
+
+    AtlasGlyph *glyph = findSlot(atlas->Glyphs, atlas->Capacity, codepoint);
+    glyph->Codepoint = codepoint;
+    glyph->Used = 1;
+    glyph->Width = width;
+    glyph->Height = height;
+    glyph->Advance = (int)face->glyph->advance.x;
+    glyph->Left = face->glyph->bitmap_left;
+    glyph->Top = face->glyph->bitmap_top;
+    glyph->X = x;
+    glyph->Y = y;
+    glyph->U0 = (float)x / atlas->Width;
+    glyph->V0 = (float)y / atlas->Height;
+    glyph->U1 = (float)(x + width) / atlas->Width;
+    glyph->V1 = (float)(y + height) / atlas->Height;
+    atlas->Count++;
+
+    return glyph;
+}
+
+int glyphAtlasAddString(GlyphAtlas *atlas, FT_Face face, const char *text)
+{
+    int failures = 0;
+    const char *p = text;
+
+    while (*p)
+    {
+        unsigned int codepoint = codepoint_from_utf8(&p);
+        if (!glyphAtlasAdd(atlas, face, codepoint))
+            failures++;
+    }
+
+    return failures;
+}
+
+int glyphAtlasIsDirty(const GlyphAtlas *atlas)
+{
+    return atlas->DirtyX1 > atlas->DirtyX0 && atlas->DirtyY1 > atlas->DirtyY0;
+}
+
+void glyphAtlasClearDirty(GlyphAtlas *atlas)
+{
+    atlas->DirtyX0 = atlas->Width;
+    atlas->DirtyY0 = atlas->Height;
+    atlas->DirtyX1 = 0;
+    atlas->DirtyY1 = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+/*
+ * CPU side glyph atlas.
+ *
+ * All glyph bitmaps are packed into one 8-bit coverage image (shelf packing),
+ * so every glyph can be drawn from a single texture in a single batch.  The
+ * atlas itself knows nothing about OpenGL: the GL backend uploads the dirty
+ * rectangle after new glyphs were added (see text_renderer.c).
+ */
+
+/* Glyph metrics + location inside the atlas */
+typedef struct
+{
+    unsigned int Codepoint; /* Unicode code point */
+    int Used;               /* Slot in hash table is occupied */
+    int Missing;            /* Glyph failed to load, cached so it is only tried once */
+    int Width;              /* Width of glyph bitmap */
+    int Height;             /* Height of glyph bitmap */
+    int Advance;            /* Horizontal advance in 1/64 pixels */
+    int Left;               /* Left offset of glyph */
+    int Top;                /* Top offset of glyph (baseline to top) */
+    int X, Y;               /* Top-left corner of the bitmap in the atlas */
+    float U0, V0, U1, V1;   /* Texture coordinates of the bitmap */
+} AtlasGlyph;
+
+typedef struct
+{
+    unsigned char *Pixels; /* Width * Height coverage values */
+    int Width;
+    int Height;
+
+    /* Shelf packer state */
+    int PenX;
+    int PenY;
+    int RowHeight;
+
+    /* Open addressing table: code point -> glyph */
+    AtlasGlyph *Glyphs;
+    int Capacity;
+    int Count;
+
+    /* Region touched since the last glyphAtlasClearDirty() */
+    int DirtyX0, DirtyY0, DirtyX1, DirtyY1;
+} GlyphAtlas;
+
+int glyphAtlasCreate(GlyphAtlas *atlas, int width, int height);
+void glyphAtlasDestroy(GlyphAtlas *atlas);
+
+/* Look up a glyph that has already been rasterized, NULL if missing or failed */
+const AtlasGlyph *glyphAtlasFind(const GlyphAtlas *atlas, unsigned int codepoint);
+
+/* Rasterize codepoint from face into the atlas (no-op if already present).
+ * Returns NULL on failure; the failure is remembered and not reported again. */
+const AtlasGlyph *glyphAtlasAdd(GlyphAtlas *atlas, FT_Face face, unsigned int codepoint);
+
+/* Rasterize every code point of a UTF-8 string, returns number of failures */
+int glyphAtlasAddString(GlyphAtlas *atlas, FT_Face face, const char *text);
+
+int glyphAtlasIsDirty(const GlyphAtlas *atlas);
+void glyphAtlasClearDirty(GlyphAtlas *atlas);
+
+#endif /* GLYPH_ATLAS_H */
@@ -7,6 +7,7 @@
 #include FT_FREETYPE_H
 #include <float.h>
 #include <time.h>
+#include "font_registry.h"
 
 /* Window dimensions */
 const GLuint WIDTH = 800, HEIGHT = 600;
@@ -242,36 +243,29 @@ void initFreeType(void)
         exit(1);
     }
 
+    /* Index installed fonts (cached on disk) instead of probing paths one by one */
+    FontRegistry fonts;
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+
     FT_Face face;
-    /* Try multiple common font paths */
-    const char *fontPaths[] = {
-        "fonts/arial.ttf",                                 /* Project directory */
-        "/usr/share/fonts/truetype/freefont/FreeSans.ttf", /* Linux */
-        "/usr/share/fonts/TTF/DejaVuSans.ttf",             /* Linux alternative */
-        "/System/Library/Fonts/Helvetica.ttc",             /* macOS */
-        "/Library/Fonts/Arial.ttf",                        /* macOS alternative */
-        "/mnt/c/Windows/Fonts/arial.ttf"                   /* Windows wsl */
+    const char *fontFamilies[] = {
+        "Arial",       /* Windows, macOS, or fonts/arial.ttf */
+        "FreeSans",    /* Linux */
+        "DejaVu Sans", /* Linux alternative */
+        "Helvetica"    /* macOS */
     };
 
-    int numPaths = sizeof(fontPaths) / sizeof(fontPaths[0]);
-    int fontLoaded = 0;
-
-    for (int i = 0; i < numPaths; i++)
-    {
-        if (FT_New_Face(ft, fontPaths[i], 0, &face) == 0)
-        {
-            printf("Successfully loaded font: %s\n", fontPaths[i]);
-            fontLoaded = 1;
-            break;
-        }
-    }
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
 
-    if (!fontLoaded)
+    if (!font)
     {
         fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        fontRegistryDestroy(&fonts);
         FT_Done_FreeType(ft);
         exit(1);
     }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
 
     /* Set size to load glyphs as */
     FT_Set_Pixel_Sizes(face, 0, 48);
@@ -321,9 +315,10 @@ void initFreeType(void)
         Characters[c] = character;
     }
 
-    /* Clean up FreeType resources */
+    /* Clean up FreeType resources, the face reads from the registry's mapping */
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
 }
 
 void renderText(const char *text, float x, float y, float scale, float r, float g, float b)
@@ -7,6 +7,8 @@
 #include FT_FREETYPE_H
 #include <float.h>
 #include <time.h>
+#include "font_registry.h"
+#include "utf8.h"
 
 /* Window dimensions */
 const GLuint WIDTH = 800, HEIGHT = 600;
@@ -56,7 +58,6 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 GLuint compileShaders(void);
 void initFreeType(void);
 void renderText(const char* text, float x, float y, float scale, float r, float g, float b);
-unsigned int codepoint_from_utf8(const char** text);
 
 int main(void) {
     /* Initialize GLFW */
@@ -146,6 +147,7 @@ int main(void) {
         const char* p = text;
         while (*p) {
             unsigned int codepoint = codepoint_from_utf8(&p);
+            if (codepoint >= MAX_CHARS) continue;
             textWidth += (Characters[codepoint].Advance >> 6) * scale;
         }
         
@@ -244,33 +246,30 @@ void initFreeType(void) {
         exit(1);
     }
     
+    /* 从字体索引中查找支持中文的字体，索引缓存在磁盘上，不再逐个尝试路径 */
+    FontRegistry fonts;
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+    
     FT_Face face;
-    /* 尝试加载支持中文的字体 */
-    const char* fontPaths[] = {
-        "/usr/share/fonts/truetype/droid/DroidSansFallbackFull.ttf",  // Linux
-        "/usr/share/fonts/noto/NotoSansCJK-Regular.ttc",              // Linux
-        "/usr/share/fonts/wenquanyi/wqy-microhei/wqy-microhei.ttc",   // Linux
-        "/mnt/c/Windows/Fonts/msyh.ttc",                                  // Windows
-        "/mnt/c/Windows/Fonts/simsun.ttc",                                // Windows
-        "/System/Library/Fonts/PingFang.ttc",                         // macOS
-        "fonts/NotoSansSC-Regular.otf"                                // 自定义路径
+    const char* fontFamilies[] = {
+        "Droid Sans Fallback",   // Linux
+        "Noto Sans CJK SC",      // Linux
+        "WenQuanYi Micro Hei",   // Linux
+        "Microsoft YaHei",       // Windows
+        "SimSun",                // Windows
+        "PingFang SC",           // macOS
+        "Noto Sans SC"           // 自定义路径 fonts/
     };
     
-    int numFonts = sizeof(fontPaths) / sizeof(fontPaths[0]);
-    int fontLoaded = 0;
-    
-    for (int i = 0; i < numFonts; i++) {
-        if (FT_New_Face(ft, fontPaths[i], 0, &face) == 0) {
-            printf("Successfully loaded font: %s\n", fontPaths[i]);
-            fontLoaded = 1;
-            break;
-        }
-    }
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    /* 都没有安装时，退而使用任何包含“你”字的字体 */
+    const FontEntry* font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 0x4F60, &face);
     
-    if (!fontLoaded) {
+    if (!font) {
         fprintf(stderr, "ERROR::FREETYPE: Failed to load any font\n");
         exit(1);
     }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
     
     /* 设置字体大小 */
     FT_Set_Pixel_Sizes(face, 0, 48);
@@ -285,6 +284,7 @@ void initFreeType(void) {
     
     while (*p) {
         unsigned int codepoint = codepoint_from_utf8(&p);
+        if (codepoint >= MAX_CHARS) continue;
         
         /* 如果字符尚未加载，则加载它 */
         if (Characters[codepoint].TextureID == 0) {
@@ -328,34 +328,13 @@ void initFreeType(void) {
         }
     }
     
-    /* 清理 FreeType 资源 */
+    /* 清理 FreeType 资源，face 读取的是 fonts 中的内存映射，最后释放 */
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
 }
 
 /* 从 UTF-8 编码的字符串中提取 Unicode 码点 */
-unsigned int codepoint_from_utf8(const char** text) {
-    unsigned int codepoint = 0;
-    const unsigned char* str = (const unsigned char*)(*text);
-    
-    if (str[0] < 0x80) {  // 单字节 ASCII
-        codepoint = str[0];
-        *text += 1;
-    } else if ((str[0] & 0xE0) == 0xC0) {  // 双字节
-        codepoint = ((str[0] & 0x1F) << 6) | (str[1] & 0x3F);
-        *text += 2;
-    } else if ((str[0] & 0xF0) == 0xE0) {  // 三字节 (中文常见)
-        codepoint = ((str[0] & 0x0F) << 12) | ((str[1] & 0x3F) << 6) | (str[2] & 0x3F);
-        *text += 3;
-    } else if ((str[0] & 0xF8) == 0xF0) {  // 四字节
-        codepoint = ((str[0] & 0x07) << 18) | ((str[1] & 0x3F) << 12) | 
-                    ((str[2] & 0x3F) << 6) | (str[3] & 0x3F);
-        *text += 4;
-    }
-    
-    return codepoint;
-}
-
 void renderText(const char* text, float x, float y, float scale, float r, float g, float b) {
     glUseProgram(shaderProgram);
     GLint colorLoc = glGetUniformLocation(shaderProgram, "textColor");
@@ -373,6 +352,7 @@ void renderText(const char* text, float x, float y, float scale, float r, float
     while (*p) {
         // 解码 UTF-8 获取 Unicode 码点
         unsigned int codepoint = codepoint_from_utf8(&p);
+        if (codepoint >= MAX_CHARS) continue;
         Character ch = Characters[codepoint];
         
         // 如果字符未加载，跳过
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "text_object.h"
+#include "text_renderer.h"
+
+/*
+ * 增量更新的 HUD
+ *
+ * 帧计数、时钟和一行较长的状态文本每帧都在变，但每次只变几个字符。
+ * TextObject 把新字符串和上一帧比较，只重新排版并用 glBufferSubData 上传
+ * 变化的字形槽。每 2 秒输出一次平均每帧上传的字节数，以及每帧整串重传
+ * 需要的字节数。
+ */
+
+/* Window dimensions */
+const GLuint WIDTH = 800, HEIGHT = 600;
+
+#define ATLAS_SIZE 512
+#define NUM_OBJECTS 3
+
+FontRegistry fonts;
+GlyphAtlas atlas;
+TextRenderer textRenderer;
+TextObject frameCounter, clockText, statusLine;
+
+/* Function prototypes */
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+void initFreeType(void);
+
+int main(void)
+{
+    /* Initialize GLFW */
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return -1;
+    }
+
+    /* Set OpenGL version and profile */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    /* Create a windowed mode window and its OpenGL context */
+    GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Incremental HUD", NULL, NULL);
+    if (!window)
+    {
+        fprintf(stderr, "Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    /* Set callback functions */
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+
+    /* Initialize GLEW */
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    initFreeType();
+
+    textRendererInit(&textRenderer, &atlas);
+    textRendererSetViewport(&textRenderer, (float)WIDTH, (float)HEIGHT);
+
+    TextObject *objects[NUM_OBJECTS] = {&frameCounter, &clockText, &statusLine};
+    textObjectInit(&frameCounter, &textRenderer, 40.0f, 120.0f, 1.0f, 255, 215, 0);
+    textObjectInit(&clockText, &textRenderer, 40.0f, 220.0f, 1.0f, 255, 255, 255);
+    textObjectInit(&statusLine, &textRenderer, 40.0f, 320.0f, 0.5f, 200, 230, 255);
+
+    /* Enable blending for text rendering */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    unsigned long frame = 0;
+    int statFrames = 0;
+    long statUpload = 0, statFull = 0;
+    double statStart = glfwGetTime();
+
+    /* Main loop */
+    while (!glfwWindowShouldClose(window))
+    {
+        /* Clear the screen */
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        /* 每帧更新三段文本，只有变化的字符会被上传 */
+        double t = glfwGetTime();
+        int ms = (int)(t * 1000.0);
+        textObjectPrintf(&frameCounter, "Frame %lu", frame);
+        textObjectPrintf(&clockText, "%02d:%02d:%02d.%03d",
+                         ms / 3600000, ms / 60000 % 60, ms / 1000 % 60, ms % 1000);
+        textObjectPrintf(&statusLine, "uptime %.1f s | frames %lu | queue %d | link OK | temp 41 C",
+                         t, frame, (int)(frame % 17));
+
+        for (int i = 0; i < NUM_OBJECTS; i++)
+        {
+            textObjectDraw(objects[i]);
+            statUpload += objects[i]->LastUploadBytes;
+            statFull += (long)objects[i]->Length * 6 * sizeof(TextVertex);
+        }
+
+        /* Swap front and back buffers */
+        glfwSwapBuffers(window);
+        frame++;
+        statFrames++;
+
+        /* Poll for and process events */
+        glfwPollEvents();
+
+        if (glfwGetTime() - statStart >= 2.0)
+        {
+            printf("uploaded %ld bytes/frame, full re-upload would be %ld bytes/frame\n",
+                   statUpload / statFrames, statFull / statFrames);
+            statFrames = 0;
+            statUpload = statFull = 0;
+            statStart = glfwGetTime();
+        }
+    }
+
+    /* Clean up */
+    for (int i = 0; i < NUM_OBJECTS; i++)
+        textObjectDestroy(objects[i]);
+    textRendererDestroy(&textRenderer);
+    glyphAtlasDestroy(&atlas);
+
+    /* Terminate GLFW */
+    glfwTerminate();
+
+    return 0;
+}
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GL_TRUE);
+}
+
+void initFreeType(void)
+{
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    /* Index installed fonts (cached on disk) and map the best match */
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(ft);
+        exit(1);
+    }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+
+    /* Set size to load glyphs as */
+    FT_Set_Pixel_Sizes(face, 0, 48);
+
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        exit(1);
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+
+    /* Clean up FreeType resources, the face reads from the registry's mapping */
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+}
@@ -0,0 +1,433 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "label_layer.h"
+#include "utf8.h"
+
+#define MAX_GRID_SIDE 1024
+#define ITEMS_PER_CELL 8
+#define SCREEN_CELL 32 /* Pixels per side of a collision grid cell */
+
+int labelLayerInit(LabelLayer *layer, const GlyphAtlas *atlas, float scale)
+{
+    memset(layer, 0, sizeof(*layer));
+    layer->Atlas = atlas;
+    layer->Scale = scale;
+    layer->Padding = 2.0f;
+    return 1;
+}
+
+void labelLayerDestroy(LabelLayer *layer)
+{
+    free(layer->Items);
+    free(layer->Text);
+    free(layer->CellStart);
+    free(layer->CellItems);
+    free(layer->Visible);
+    free(layer->ScreenHeads);
+    free(layer->NodeNext);
+    free(layer->NodeBox);
+    free(layer->Boxes);
+    memset(layer, 0, sizeof(*layer));
+}
+
+void labelLayerClear(LabelLayer *layer)
+{
+    layer->Count = 0;
+    layer->TextSize = 0;
+    layer->Dirty = 1;
+}
+
+/* Grow *array to hold at least count elements of size bytes each */
+static int reserveArray(void **array, int *capacity, int count, size_t size)
+{
+    if (count <= *capacity)
+        return 1;
+
+    int newCapacity = *capacity ? *capacity : 256;
+    while (newCapacity < count)
+        newCapacity *= 2;
+
+    void *grown = realloc(*array, newCapacity * size);
+    if (!grown)
+        return 0;
+
+    *array = grown;
+    *capacity = newCapacity;
+    return 1;
+}
+
+/* Advance width and the extent above and below the baseline, in pixels */
+static void measureLabel(const GlyphAtlas *atlas, const char *text, float scale, LabelItem *item)
+{
+    float width = 0.0f;
+    int ascent = 0, descent = 0;
+    const char *p = text;
+
+    while (*p)
+    {
+        const AtlasGlyph *glyph = glyphAtlasFind(atlas, codepoint_from_utf8(&p));
+        if (!glyph)
+            continue;
+
+        width += (glyph->Advance >> 6) * scale;
+        if (glyph->Top > ascent)
+            ascent = glyph->Top;
+        if (glyph->Height - glyph->Top > descent)
+            descent = glyph->Height - glyph->Top;
+    }
+
+    item->Width = width;
+    item->Ascent = ascent * scale;
+    item->Descent = descent * scale;
+}
+
+int labelLayerAdd(LabelLayer *layer, const Label *labels, int count)
+{
+    if (!reserveArray((void **)&layer->Items, &layer->Capacity, layer->Count + count, sizeof(LabelItem)))
+        return 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        const Label *label = &labels[i];
+        int length = (int)strlen(label->Text) + 1;
+        int textCapacity = layer->TextCapacity;
+        if (!reserveArray((void **)&layer->Text, &textCapacity, layer->TextSize + length, 1))
+            return 0;
+        layer->TextCapacity = textCapacity;
+
+        LabelItem *item = &layer->Items[layer->Count++];
+        item->X = label->X;
+        item->Y = label->Y;
+        item->R = label->R;
+        item->G = label->G;
+        item->B = label->B;
+        item->Priority = label->Priority;
+        item->Text = layer->TextSize;
+        memcpy(layer->Text + layer->TextSize, label->Text, length);
+        layer->TextSize += length;
+
+        measureLabel(layer->Atlas, label->Text, layer->Scale, item);
+    }
+
+    layer->Dirty = 1;
+    return 1;
+}
+
+int labelLayerAddRandom(LabelLayer *layer, int count, float worldSize)
+{
+    srand(12345);
+
+    Label batch[1024];
+    char text[1024][16];
+    for (int i = 0; i < count;)
+    {
+        int n = count - i < 1024 ? count - i : 1024;
+        for (int j = 0; j < n; j++, i++)
+        {
+            Label *label = &batch[j];
+            label->X = worldSize * rand() / RAND_MAX;
+            label->Y = worldSize * rand() / RAND_MAX;
+            label->Priority = (float)(rand() % 1000);
+            if (i % 4 == 0)
+                snprintf(text[j], sizeof(text[j]), "%.2f", label->Priority / 10.0f);
+            else
+                snprintf(text[j], sizeof(text[j]), "#%d", i);
+            label->Text = text[j];
+
+            /* 高优先级金色，其余白色和灰色 */
+            float shade = label->Priority >= 900 ? 0 : (label->Priority >= 500 ? 255 : 160);
+            label->R = label->Priority >= 900 ? 255 : shade;
+            label->G = label->Priority >= 900 ? 215 : shade;
+            label->B = shade;
+        }
+        if (!labelLayerAdd(layer, batch, n))
+        {
+            fprintf(stderr, "ERROR::LABELS: Out of memory after %d labels\n", i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Higher priority first, equal priorities keep the order they were added in */
+static int compareItems(const void *a, const void *b)
+{
+    const LabelItem *ia = (const LabelItem *)a;
+    const LabelItem *ib = (const LabelItem *)b;
+    if (ia->Priority != ib->Priority)
+        return ia->Priority > ib->Priority ? -1 : 1;
+    return ia->Text - ib->Text;
+}
+
+static int gridCell(const LabelLayer *layer, float x, float y)
+{
+    int column = (int)((x - layer->GridX0) / layer->CellWidth);
+    int row = (int)((y - layer->GridY0) / layer->CellHeight);
+    if (column >= layer->GridColumns)
+        column = layer->GridColumns - 1;
+    if (row >= layer->GridRows)
+        row = layer->GridRows - 1;
+    return row * layer->GridColumns + column;
+}
+
+/* Sort by priority and bucket the labels into the world grid */
+static int buildIndex(LabelLayer *layer)
+{
+    int count = layer->Count;
+    qsort(layer->Items, count, sizeof(LabelItem), compareItems);
+
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    layer->MaxWidth = 0.0f;
+    layer->MaxHeight = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        const LabelItem *item = &layer->Items[i];
+        if (i == 0 || item->X < minX)
+            minX = item->X;
+        if (i == 0 || item->X > maxX)
+            maxX = item->X;
+        if (i == 0 || item->Y < minY)
+            minY = item->Y;
+        if (i == 0 || item->Y > maxY)
+            maxY = item->Y;
+        if (item->Width > layer->MaxWidth)
+            layer->MaxWidth = item->Width;
+        if (item->Ascent + item->Descent > layer->MaxHeight)
+            layer->MaxHeight = item->Ascent + item->Descent;
+    }
+
+    /* About ITEMS_PER_CELL labels per cell when they are spread evenly */
+    int side = (int)sqrtf((float)count / ITEMS_PER_CELL);
+    if (side < 1)
+        side = 1;
+    if (side > MAX_GRID_SIDE)
+        side = MAX_GRID_SIDE;
+    layer->GridX0 = minX;
+    layer->GridY0 = minY;
+    layer->GridColumns = side;
+    layer->GridRows = side;
+    layer->CellWidth = maxX > minX ? (maxX - minX) / side : 1.0f;
+    layer->CellHeight = maxY > minY ? (maxY - minY) / side : 1.0f;
+
+    int cells = side * side;
+    free(layer->CellStart);
+    free(layer->CellItems);
+    free(layer->Visible);
+    layer->CellStart = (int *)calloc(cells + 1, sizeof(int));
+    layer->CellItems = (int *)malloc((count ? count : 1) * sizeof(int));
+    layer->Visible = (unsigned char *)calloc(count ? count : 1, 1);
+    if (!layer->CellStart || !layer->CellItems || !layer->Visible)
+    {
+        fprintf(stderr, "ERROR::LABELS: Failed to allocate index for %d labels\n", count);
+        return 0;
+    }
+
+    /* Counting sort by cell; each bucket stays in priority order */
+    for (int i = 0; i < count; i++)
+        layer->CellStart[gridCell(layer, layer->Items[i].X, layer->Items[i].Y) + 1]++;
+    for (int i = 0; i < cells; i++)
+        layer->CellStart[i + 1] += layer->CellStart[i];
+
+    int *fill = (int *)malloc(cells * sizeof(int));
+    if (!fill)
+        return 0;
+    memcpy(fill, layer->CellStart, cells * sizeof(int));
+    for (int i = 0; i < count; i++)
+        layer->CellItems[fill[gridCell(layer, layer->Items[i].X, layer->Items[i].Y)]++] = i;
+    free(fill);
+
+    layer->Dirty = 0;
+    return 1;
+}
+
+/* Screen box of an item, grown by the padding */
+static void itemBox(const LabelLayer *layer, const LabelItem *item, const LabelView *view,
+                    float scaleX, float scaleY, float box[4])
+{
+    float cx = (item->X - view->X0) * scaleX;
+    float cy = (item->Y - view->Y0) * scaleY;
+    float halfHeight = (item->Ascent + item->Descent) * 0.5f;
+    box[0] = cx - item->Width * 0.5f - layer->Padding;
+    box[1] = cy - halfHeight - layer->Padding;
+    box[2] = cx + item->Width * 0.5f + layer->Padding;
+    box[3] = cy + halfHeight + layer->Padding;
+}
+
+static int prepareScreenGrid(LabelLayer *layer, const LabelView *view)
+{
+    int columns = (int)ceilf(view->Width / SCREEN_CELL);
+    int rows = (int)ceilf(view->Height / SCREEN_CELL);
+    if (columns < 1)
+        columns = 1;
+    if (rows < 1)
+        rows = 1;
+
+    if (columns * rows > layer->ScreenColumns * layer->ScreenRows || !layer->ScreenHeads)
+    {
+        int *heads = (int *)realloc(layer->ScreenHeads, columns * rows * sizeof(int));
+        if (!heads)
+            return 0;
+        layer->ScreenHeads = heads;
+    }
+    layer->ScreenColumns = columns;
+    layer->ScreenRows = rows;
+    memset(layer->ScreenHeads, 0xFF, columns * rows * sizeof(int)); /* All -1 */
+    layer->NodeCount = 0;
+    return 1;
+}
+
+/* Cells of the collision grid covered by a box, clamped to the screen */
+static void screenCells(const LabelLayer *layer, const float box[4], int *c0, int *r0, int *c1, int *r1)
+{
+    *c0 = (int)(box[0] / SCREEN_CELL);
+    *r0 = (int)(box[1] / SCREEN_CELL);
+    *c1 = (int)(box[2] / SCREEN_CELL);
+    *r1 = (int)(box[3] / SCREEN_CELL);
+    if (*c0 < 0)
+        *c0 = 0;
+    if (*r0 < 0)
+        *r0 = 0;
+    if (*c1 >= layer->ScreenColumns)
+        *c1 = layer->ScreenColumns - 1;
+    if (*r1 >= layer->ScreenRows)
+        *r1 = layer->ScreenRows - 1;
+}
+
+static int overlapsPlaced(const LabelLayer *layer, const float box[4])
+{
+    int c0, r0, c1, r1;
+    screenCells(layer, box, &c0, &r0, &c1, &r1);
+
+    for (int row = r0; row <= r1; row++)
+    {
+        for (int column = c0; column <= c1; column++)
+        {
+            for (int node = layer->ScreenHeads[row * layer->ScreenColumns + column]; node >= 0;
+                 node = layer->NodeNext[node])
+            {
+                const float *other = &layer->Boxes[4 * layer->NodeBox[node]];
+                if (box[0] < other[2] && other[0] < box[2] && box[1] < other[3] && other[1] < box[3])
+                    return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int insertPlaced(LabelLayer *layer, const float box[4])
+{
+    int index = layer->Placed;
+    int boxCapacity = layer->BoxCapacity;
+    if (!reserveArray((void **)&layer->Boxes, &boxCapacity, 4 * (index + 1), sizeof(float)))
+        return 0;
+    layer->BoxCapacity = boxCapacity;
+    memcpy(&layer->Boxes[4 * index], box, 4 * sizeof(float));
+
+    int c0, r0, c1, r1;
+    screenCells(layer, box, &c0, &r0, &c1, &r1);
+
+    int needed = layer->NodeCount + (c1 - c0 + 1) * (r1 - r0 + 1);
+    if (needed > layer->NodeCapacity)
+    {
+        int capacity = layer->NodeCapacity;
+        if (!reserveArray((void **)&layer->NodeNext, &capacity, needed, sizeof(int)))
+            return 0;
+        capacity = layer->NodeCapacity;
+        if (!reserveArray((void **)&layer->NodeBox, &capacity, needed, sizeof(int)))
+            return 0;
+        layer->NodeCapacity = capacity;
+    }
+
+    for (int row = r0; row <= r1; row++)
+    {
+        for (int column = c0; column <= c1; column++)
+        {
+            int *head = &layer->ScreenHeads[row * layer->ScreenColumns + column];
+            int node = layer->NodeCount++;
+            layer->NodeBox[node] = index;
+            layer->NodeNext[node] = *head;
+            *head = node;
+        }
+    }
+    return 1;
+}
+
+int labelLayerLayout(LabelLayer *layer, DrawList *list, const LabelView *view)
+{
+    layer->Candidates = 0;
+    layer->Placed = 0;
+    if (layer->Count == 0 || view->X1 <= view->X0 || view->Y1 <= view->Y0)
+        return 0;
+    if (layer->Dirty && !buildIndex(layer))
+        return 0;
+    if (!prepareScreenGrid(layer, view))
+        return 0;
+
+    float scaleX = view->Width / (view->X1 - view->X0);
+    float scaleY = view->Height / (view->Y1 - view->Y0);
+
+    /* 1. 视口裁剪：只访问与视口（加上最大标签尺寸）相交的网格单元 */
+    float marginX = (layer->MaxWidth * 0.5f + layer->Padding) / scaleX;
+    float marginY = (layer->MaxHeight * 0.5f + layer->Padding) / scaleY;
+    int c0 = (int)floorf((view->X0 - marginX - layer->GridX0) / layer->CellWidth);
+    int r0 = (int)floorf((view->Y0 - marginY - layer->GridY0) / layer->CellHeight);
+    int c1 = (int)floorf((view->X1 + marginX - layer->GridX0) / layer->CellWidth);
+    int r1 = (int)floorf((view->Y1 + marginY - layer->GridY0) / layer->CellHeight);
+    if (c0 < 0)
+        c0 = 0;
+    if (r0 < 0)
+        r0 = 0;
+    if (c1 >= layer->GridColumns)
+        c1 = layer->GridColumns - 1;
+    if (r1 >= layer->GridRows)
+        r1 = layer->GridRows - 1;
+
+    int first = layer->Count, last = -1;
+    for (int row = r0; row <= r1; row++)
+    {
+        for (int column = c0; column <= c1; column++)
+        {
+            int cell = row * layer->GridColumns + column;
+            for (int k = layer->CellStart[cell]; k < layer->CellStart[cell + 1]; k++)
+            {
+                int i = layer->CellItems[k];
+                float box[4];
+                itemBox(layer, &layer->Items[i], view, scaleX, scaleY, box);
+                if (box[2] <= 0.0f || box[0] >= view->Width || box[3] <= 0.0f || box[1] >= view->Height)
+                    continue;
+
+                layer->Visible[i] = 1;
+                layer->Candidates++;
+                if (i < first)
+                    first = i;
+                if (i > last)
+                    last = i;
+            }
+        }
+    }
+
+    /* 2. 按优先级从高到低放置，与已放置标签重叠的丢弃 */
+    for (int i = first; i <= last; i++)
+    {
+        if (!layer->Visible[i])
+            continue;
+        layer->Visible[i] = 0;
+
+        const LabelItem *item = &layer->Items[i];
+        float box[4];
+        itemBox(layer, item, view, scaleX, scaleY, box);
+        if (overlapsPlaced(layer, box) || !insertPlaced(layer, box))
+            continue;
+        layer->Placed++;
+
+        /* 3. 幸存者追加到同一个 DrawList */
+        float x = box[0] + layer->Padding;
+        float baseline = box[1] + layer->Padding + item->Ascent;
+        layoutText(list, layer->Atlas, layer->Text + item->Text, x, baseline, layer->Scale,
+                   item->R, item->G, item->B);
+    }
+
+    return layer->Placed;
+}
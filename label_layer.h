@@ -0,0 +1,110 @@
+#ifndef LABEL_LAYER_H
+#define LABEL_LAYER_H
+
+#include "glyph_atlas.h"
+#include "text_layout.h"
+
+/*
+ * Label layer: tens of thousands of short screen-space labels per frame.
+ *
+ * Labels are anchored at points in world space but keep their pixel size,
+ * like the IDs and values of a data plot.  Every frame the layer
+ *
+ *   1. finds the labels near the visible world rectangle through a uniform
+ *      grid built once after the labels were added,
+ *   2. walks them from the highest priority down and drops every label whose
+ *      box overlaps one that was already placed (a screen-space grid of
+ *      placed boxes keeps this test local),
+ *   3. appends the survivors to one DrawList, ready for a single draw call.
+ *
+ * Nothing here touches OpenGL.  The glyphs of all labels must already be in
+ * the atlas.
+ */
+
+/* Input record for labelLayerAdd() */
+typedef struct
+{
+    float X, Y;      /* Anchor in world space, the label is centered on it */
+    float Priority;  /* Higher wins when two labels overlap */
+    float R, G, B;   /* 0-255 */
+    const char *Text; /* UTF-8, copied by the layer */
+} Label;
+
+/* Visible part of the world and the viewport it is mapped onto (y axis down) */
+typedef struct
+{
+    float X0, Y0, X1, Y1; /* World rectangle */
+    float Width, Height;  /* Viewport in pixels */
+} LabelView;
+
+/* Stored label, kept sorted by priority */
+typedef struct
+{
+    float X, Y;
+    float Width, Ascent, Descent; /* Pixels at the layer's scale */
+    float R, G, B;
+    float Priority;
+    int Text; /* Offset into LabelLayer.Text */
+} LabelItem;
+
+typedef struct
+{
+    const GlyphAtlas *Atlas;
+    float Scale;
+    float Padding; /* Minimum gap between two placed labels in pixels */
+
+    LabelItem *Items; /* Sorted by priority once the index is built */
+    int Count;
+    int Capacity;
+
+    char *Text;
+    int TextSize;
+    int TextCapacity;
+    int Dirty; /* Labels changed since the index was built */
+
+    /* World grid: items of cell i are CellItems[CellStart[i] .. CellStart[i + 1]) */
+    float GridX0, GridY0, CellWidth, CellHeight;
+    int GridColumns, GridRows;
+    int *CellStart;
+    int *CellItems;
+    float MaxWidth, MaxHeight;
+
+    /* Per frame scratch */
+    unsigned char *Visible;
+    int *ScreenHeads;  /* Screen grid of placed boxes, one list per cell */
+    int ScreenColumns, ScreenRows;
+    int *NodeNext;
+    int *NodeBox;
+    int NodeCount, NodeCapacity;
+    float *Boxes; /* x0, y0, x1, y1 of every placed label */
+    int BoxCapacity;
+
+    /* Statistics of the last labelLayerLayout() */
+    int Candidates; /* Labels inside the view */
+    int Placed;     /* Labels that survived the overlap test */
+} LabelLayer;
+
+int labelLayerInit(LabelLayer *layer, const GlyphAtlas *atlas, float scale);
+void labelLayerDestroy(LabelLayer *layer);
+
+/* Remove all labels */
+void labelLayerClear(LabelLayer *layer);
+
+/* Append count labels, returns 0 when out of memory */
+int labelLayerAdd(LabelLayer *layer, const Label *labels, int count);
+
+/*
+ * Add count labels with IDs and values scattered uniformly over
+ * [0, worldSize)^2 and random priorities, the same set on every call.
+ * Test data for the Labels demo and LabelBench.
+ */
+int labelLayerAddRandom(LabelLayer *layer, int count, float worldSize);
+
+/*
+ * Cull, resolve overlaps and append the surviving labels to list.
+ * Rebuilds the spatial index first if labels were added since the last call.
+ * Returns the number of labels placed.
+ */
+int labelLayerLayout(LabelLayer *layer, DrawList *list, const LabelView *view);
+
+#endif /* LABEL_LAYER_H */
@@ -0,0 +1,201 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "label_layer.h"
+#include "soft_renderer.h"
+#include "text_layout.h"
+
+/*
+ * 标签层性能测试
+ *
+ * 不打开窗口：生成大量随机分布的标签，让视口从整个世界缩放到局部再平移。
+ * 每帧分别统计裁剪、重叠剔除和排版的耗时，以及用软件后端把结果合成到
+ * 1920x1080 图像的耗时，两者之和与 60 fps 的 16.7 ms 预算比较。GL 提交的
+ * 耗时不在这里，见 Labels 演示每 2 秒的输出。给出输出文件名时，把第一帧
+ * （整个世界）写成 PPM 图像。最慢的一帧超出预算时返回 1。
+ *
+ *     LabelBench [count frames [output.ppm]]
+ */
+
+/* Viewport of the GL demo */
+const int WIDTH = 1920, HEIGHT = 1080;
+
+#define ATLAS_SIZE 256
+#define WORLD_SIZE 10000.0f
+#define FRAME_BUDGET_MS (1000.0 / 60.0)
+
+FontRegistry fonts;
+GlyphAtlas atlas;
+LabelLayer layer;
+DrawList drawList;
+
+/* Function prototypes */
+void initFreeType(void);
+void viewAt(LabelView *view, int frame, int frames);
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    int frames = argc > 2 ? atoi(argv[2]) : 240;
+    const char *output = argc > 3 ? argv[3] : NULL;
+    if (count < 1 || frames < 1)
+    {
+        fprintf(stderr, "Usage: %s [count frames [output.ppm]]\n", argv[0]);
+        return -1;
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int numThreads = cpus > 0 ? (int)cpus : 1;
+
+    initFreeType();
+    drawListInit(&drawList);
+    labelLayerInit(&layer, &atlas, 1.0f);
+
+    double start = now();
+    if (!labelLayerAddRandom(&layer, count, WORLD_SIZE))
+        return -1;
+    LabelView view;
+    viewAt(&view, 0, frames);
+    labelLayerLayout(&layer, &drawList, &view); /* Builds the index */
+    printf("%d labels indexed in %.1f ms\n", count, (now() - start) * 1000.0);
+
+    SoftTarget target;
+    if (!softTargetCreate(&target, WIDTH, HEIGHT))
+        return -1;
+
+    double layoutTotal = 0.0, layoutWorst = 0.0;
+    double renderTotal = 0.0, renderWorst = 0.0;
+    double frameTotal = 0.0, frameWorst = 0.0;
+    long candidates = 0, placed = 0, vertices = 0;
+    for (int i = 0; i < frames; i++)
+    {
+        viewAt(&view, i, frames);
+
+        start = now();
+        drawListClear(&drawList);
+        labelLayerLayout(&layer, &drawList, &view);
+        double layoutEnd = now();
+
+        /* 软件后端代替上传和绘制，得到完整的一帧 */
+        softTargetClear(&target, 0.2f, 0.3f, 0.3f, 1.0f);
+        softRenderDrawList(&target, &atlas, &drawList, numThreads);
+        double end = now();
+
+        double layout = (layoutEnd - start) * 1000.0;
+        double render = (end - layoutEnd) * 1000.0;
+        double frame = (end - start) * 1000.0;
+        layoutTotal += layout;
+        renderTotal += render;
+        frameTotal += frame;
+        if (layout > layoutWorst)
+            layoutWorst = layout;
+        if (render > renderWorst)
+            renderWorst = render;
+        if (frame > frameWorst)
+            frameWorst = frame;
+
+        candidates += layer.Candidates;
+        placed += layer.Placed;
+        vertices += drawList.Count;
+
+        /* 第一帧显示整个世界 */
+        if (i == 0 && output && !softTargetWritePPM(&target, output))
+            fprintf(stderr, "Failed to write %s\n", output);
+    }
+
+    printf("%d frames at %dx%d: %ld labels in view, %ld placed, %ld vertices per frame on average\n",
+           frames, WIDTH, HEIGHT, candidates / frames, placed / frames, vertices / frames);
+    printf("layout time     avg %.3f ms  worst %.3f ms\n", layoutTotal / frames, layoutWorst);
+    printf("software render avg %.3f ms  worst %.3f ms  (%d threads, %s blending)\n",
+           renderTotal / frames, renderWorst, numThreads, softRenderBackendName());
+    printf("frame           avg %.3f ms  worst %.3f ms  (60 fps budget %.1f ms: %s)\n",
+           frameTotal / frames, frameWorst, FRAME_BUDGET_MS, frameWorst < FRAME_BUDGET_MS ? "ok" : "exceeded");
+    if (output)
+        printf("Wrote %s (first frame)\n", output);
+
+    softTargetDestroy(&target);
+    labelLayerDestroy(&layer);
+    drawListFree(&drawList);
+    glyphAtlasDestroy(&atlas);
+    return frameWorst < FRAME_BUDGET_MS ? 0 : 1;
+}
+
+/* Zoom from the whole world down to 1/64 of it, then pan across */
+void viewAt(LabelView *view, int frame, int frames)
+{
+    float t = (float)frame / frames;
+    float aspect = (float)HEIGHT / WIDTH;
+    float width, cx, cy;
+    if (t < 0.5f)
+    {
+        width = WORLD_SIZE * powf(64.0f, -2.0f * t);
+        cx = WORLD_SIZE * 0.5f;
+    }
+    else
+    {
+        width = WORLD_SIZE / 64.0f;
+        cx = WORLD_SIZE * (t - 0.5f) * 2.0f;
+    }
+    cy = WORLD_SIZE * 0.5f;
+
+    view->X0 = cx - width * 0.5f;
+    view->X1 = cx + width * 0.5f;
+    view->Y0 = cy - width * aspect * 0.5f;
+    view->Y1 = cy + width * aspect * 0.5f;
+    view->Width = (float)WIDTH;
+    view->Height = (float)HEIGHT;
+}
+
+void initFreeType(void)
+{
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    /* Index installed fonts (cached on disk) and map the best match */
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(ft);
+        exit(1);
+    }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+
+    /* Labels are small, rasterize them at their final size */
+    FT_Set_Pixel_Sizes(face, 0, 16);
+
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        exit(1);
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+
+    /* Clean up FreeType resources, the face reads from the registry's mapping */
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+}
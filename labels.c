@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "label_layer.h"
+#include "text_layout.h"
+#include "text_renderer.h"
+
+/*
+ * 大量屏幕空间标签
+ *
+ * 默认 10 万个标签随机分布在一个 10000 x 10000 的世界里。每帧由 LabelLayer
+ * 裁剪掉视口外的标签、丢弃被高优先级标签遮挡的标签，剩下的放进一个 DrawList
+ * 一次绘制。滚轮缩放，按住左键拖动平移，每 2 秒输出一次各阶段耗时。
+ * 默认 submit 只是提交命令的 CPU 时间；加 --sync 时每帧 glFinish()，submit
+ * 包含 GPU 完成绘制的时间，但 CPU 和 GPU 不再并行，帧时间会变长。
+ *
+ *     Labels [count] [--sync]
+ */
+
+/* Window dimensions */
+const GLuint WIDTH = 1280, HEIGHT = 720;
+
+#define ATLAS_SIZE 256
+#define WORLD_SIZE 10000.0f
+
+FontRegistry fonts;
+GlyphAtlas atlas;
+LabelLayer layer;
+TextRenderer textRenderer;
+GLuint VAO;
+
+/* Visible world rectangle and viewport */
+LabelView view;
+double dragX, dragY;
+int dragging = 0;
+
+/* Function prototypes */
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+void scroll_callback(GLFWwindow *window, double xoffset, double yoffset);
+void mouse_button_callback(GLFWwindow *window, int button, int action, int mods);
+void cursor_position_callback(GLFWwindow *window, double x, double y);
+void initFreeType(void);
+
+int main(int argc, char **argv)
+{
+    int count = 100000, sync = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--sync") == 0)
+            sync = 1;
+        else
+            count = atoi(argv[i]);
+    }
+
+    /* Initialize GLFW */
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return -1;
+    }
+
+    /* Set OpenGL version and profile */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    /* Create a windowed mode window and its OpenGL context */
+    GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Labels", NULL, NULL);
+    if (!window)
+    {
+        fprintf(stderr, "Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0); /* Measure the real frame time */
+
+    /* Set callback functions */
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+    glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+
+    /* Initialize GLEW */
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    initFreeType();
+    labelLayerInit(&layer, &atlas, 1.0f);
+    if (!labelLayerAddRandom(&layer, count, WORLD_SIZE))
+        return -1;
+
+    textRendererInit(&textRenderer, &atlas);
+    VAO = textRendererCreateVAO(&textRenderer);
+
+    /* 初始视口显示整个世界 */
+    view.Width = (float)WIDTH;
+    view.Height = (float)HEIGHT;
+    view.X0 = 0.0f;
+    view.X1 = WORLD_SIZE;
+    view.Y0 = WORLD_SIZE * 0.5f * (1.0f - (float)HEIGHT / WIDTH);
+    view.Y1 = view.Y0 + WORLD_SIZE * HEIGHT / WIDTH;
+    textRendererSetViewport(&textRenderer, view.Width, view.Height);
+
+    /* Enable blending for text rendering */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    DrawList list;
+    drawListInit(&list);
+
+    int statFrames = 0;
+    long statPlaced = 0;
+    double statLayout = 0.0, statSubmit = 0.0, statStart = glfwGetTime();
+
+    /* Main loop */
+    while (!glfwWindowShouldClose(window))
+    {
+        /* Clear the screen */
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        double layoutStart = glfwGetTime();
+        drawListClear(&list);
+        statPlaced += labelLayerLayout(&layer, &list, &view);
+        double submitStart = glfwGetTime();
+        textRendererSubmit(&textRenderer, VAO, &list);
+        if (sync)
+            glFinish();
+        statLayout += submitStart - layoutStart;
+        statSubmit += glfwGetTime() - submitStart;
+        statFrames++;
+
+        /* Swap front and back buffers */
+        glfwSwapBuffers(window);
+
+        /* Poll for and process events */
+        glfwPollEvents();
+
+        double elapsed = glfwGetTime() - statStart;
+        if (elapsed >= 2.0)
+        {
+            printf("labels %d  in view %d  placed %ld  layout %.3f ms  submit %.3f ms  frame %.3f ms\n",
+                   layer.Count, layer.Candidates, statPlaced / statFrames,
+                   1000.0 * statLayout / statFrames,
+                   1000.0 * statSubmit / statFrames,
+                   1000.0 * elapsed / statFrames);
+            statFrames = 0;
+            statPlaced = 0;
+            statLayout = statSubmit = 0.0;
+            statStart = glfwGetTime();
+        }
+    }
+
+    /* Clean up */
+    drawListFree(&list);
+    labelLayerDestroy(&layer);
+    glDeleteVertexArrays(1, &VAO);
+    textRendererDestroy(&textRenderer);
+    glyphAtlasDestroy(&atlas);
+
+    /* Terminate GLFW */
+    glfwTerminate();
+
+    return 0;
+}
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+    if (width <= 0 || height <= 0)
+        return;
+
+    /* Keep the world scale, show more or less of it */
+    float scale = (view.X1 - view.X0) / view.Width;
+    view.X1 = view.X0 + width * scale;
+    view.Y1 = view.Y0 + height * scale;
+    view.Width = (float)width;
+    view.Height = (float)height;
+    textRendererSetViewport(&textRenderer, view.Width, view.Height);
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GL_TRUE);
+}
+
+/* Zoom around the cursor */
+void scroll_callback(GLFWwindow *window, double xoffset, double yoffset)
+{
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    float wx = view.X0 + (float)x / view.Width * (view.X1 - view.X0);
+    float wy = view.Y0 + (float)y / view.Height * (view.Y1 - view.Y0);
+    float factor = powf(0.8f, (float)yoffset);
+
+    view.X0 = wx + (view.X0 - wx) * factor;
+    view.X1 = wx + (view.X1 - wx) * factor;
+    view.Y0 = wy + (view.Y0 - wy) * factor;
+    view.Y1 = wy + (view.Y1 - wy) * factor;
+}
+
+void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
+{
+    if (button != GLFW_MOUSE_BUTTON_LEFT)
+        return;
+    dragging = action == GLFW_PRESS;
+    glfwGetCursorPos(window, &dragX, &dragY);
+}
+
+void cursor_position_callback(GLFWwindow *window, double x, double y)
+{
+    if (!dragging)
+        return;
+
+    float dx = (float)(x - dragX) / view.Width * (view.X1 - view.X0);
+    float dy = (float)(y - dragY) / view.Height * (view.Y1 - view.Y0);
+    view.X0 -= dx;
+    view.X1 -= dx;
+    view.Y0 -= dy;
+    view.Y1 -= dy;
+    dragX = x;
+    dragY = y;
+}
+
+void initFreeType(void)
+{
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    /* Index installed fonts (cached on disk) and map the best match */
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(ft);
+        exit(1);
+    }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+
+    /* Labels are small, rasterize them at their final size */
+    FT_Set_Pixel_Sizes(face, 0, 16);
+
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        exit(1);
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+
+    /* Clean up FreeType resources, the face reads from the registry's mapping */
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+}
@@ -0,0 +1,265 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "line_ring.h"
+
+#define READ_CHUNK (64 * 1024)
+#define POLL_TIMEOUT_MS 100 /* How often a blocked reader checks for lineRingStop() */
+
+int lineRingInit(LineRing *ring, int capacity, int blocking)
+{
+    memset(ring, 0, sizeof(*ring));
+
+    int size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    ring->Text = (char *)malloc((size_t)size * LINE_RING_LINE_MAX);
+    ring->Length = (unsigned short *)calloc(size, sizeof(unsigned short));
+    if (!ring->Text || !ring->Length)
+    {
+        fprintf(stderr, "ERROR::LINERING: Failed to allocate %d lines\n", size);
+        free(ring->Text);
+        free(ring->Length);
+        return 0;
+    }
+
+    ring->Capacity = size;
+    ring->Blocking = blocking;
+    pthread_mutex_init(&ring->Lock, NULL);
+    pthread_cond_init(&ring->NotFull, NULL);
+    atomic_init(&ring->Running, 0);
+    atomic_init(&ring->Finished, 0);
+    return 1;
+}
+
+void lineRingDestroy(LineRing *ring)
+{
+    lineRingStop(ring);
+    pthread_cond_destroy(&ring->NotFull);
+    pthread_mutex_destroy(&ring->Lock);
+    free(ring->Text);
+    free(ring->Length);
+    memset(ring, 0, sizeof(*ring));
+}
+
+/* Caller holds the lock; length may exceed LINE_RING_LINE_MAX */
+static void appendLocked(LineRing *ring, const char *text, int length)
+{
+    unsigned long long capacity = (unsigned long long)ring->Capacity;
+
+    if (ring->Head - ring->Consumed >= capacity)
+    {
+        if (ring->Blocking)
+        {
+            /* 背压：等消费者取走，期间不再读输入，写端会阻塞在管道上 */
+            ring->Stats.Stalls++;
+            while (ring->Head - ring->Consumed >= capacity && atomic_load(&ring->Running))
+                pthread_cond_wait(&ring->NotFull, &ring->Lock);
+            if (!atomic_load(&ring->Running))
+                return;
+        }
+        else
+        {
+            /* The oldest line is overwritten without ever being seen */
+            ring->Stats.Dropped++;
+        }
+    }
+
+    if (length > LINE_RING_LINE_MAX)
+    {
+        length = LINE_RING_LINE_MAX;
+        ring->Stats.Truncated++;
+    }
+
+    int slot = (int)(ring->Head & (capacity - 1));
+    memcpy(ring->Text + (size_t)slot * LINE_RING_LINE_MAX, text, length);
+    ring->Length[slot] = (unsigned short)length;
+    ring->Head++;
+    ring->Stats.Lines++;
+}
+
+void lineRingPush(LineRing *ring, const char *text, int length)
+{
+    pthread_mutex_lock(&ring->Lock);
+    appendLocked(ring, text, length);
+    pthread_mutex_unlock(&ring->Lock);
+}
+
+unsigned long long lineRingAcquire(LineRing *ring)
+{
+    pthread_mutex_lock(&ring->Lock);
+    ring->Consumed = ring->Head;
+    return ring->Head;
+}
+
+void lineRingRelease(LineRing *ring)
+{
+    pthread_cond_signal(&ring->NotFull);
+    pthread_mutex_unlock(&ring->Lock);
+}
+
+const char *lineRingLine(const LineRing *ring, unsigned long long seq, int *length)
+{
+    if (seq >= ring->Head || ring->Head - seq > (unsigned long long)ring->Capacity)
+        return NULL;
+
+    int slot = (int)(seq & (unsigned long long)(ring->Capacity - 1));
+    *length = ring->Length[slot];
+    return ring->Text + (size_t)slot * LINE_RING_LINE_MAX;
+}
+
+void lineRingGetStats(LineRing *ring, LineRingStats *stats)
+{
+    pthread_mutex_lock(&ring->Lock);
+    *stats = ring->Stats;
+    stats->Pending = ring->Head - ring->Consumed;
+    pthread_mutex_unlock(&ring->Lock);
+}
+
+/* Line being assembled across read() calls */
+typedef struct
+{
+    char Text[LINE_RING_LINE_MAX];
+    int Length; /* Total bytes seen, may exceed what fits in Text */
+} PartialLine;
+
+static void appendPartial(PartialLine *partial, const char *text, int length)
+{
+    int room = LINE_RING_LINE_MAX - partial->Length;
+    if (room > 0)
+        memcpy(partial->Text + partial->Length, text, length < room ? length : room);
+    partial->Length += length;
+}
+
+/* Split a chunk into lines and append them under one lock */
+static void appendChunk(LineRing *ring, PartialLine *partial, const char *chunk, int size)
+{
+    const char *p = chunk, *end = chunk + size;
+
+    pthread_mutex_lock(&ring->Lock);
+    ring->Stats.Bytes += size;
+    while (p < end)
+    {
+        const char *newline = (const char *)memchr(p, '\n', end - p);
+        if (!newline)
+        {
+            appendPartial(partial, p, (int)(end - p));
+            break;
+        }
+
+        const char *text = p;
+        int length = (int)(newline - p);
+        if (partial->Length > 0)
+        {
+            appendPartial(partial, p, length);
+            text = partial->Text;
+            length = partial->Length;
+            partial->Length = 0;
+        }
+
+        /* CRLF input */
+        if (length > 0 && length <= LINE_RING_LINE_MAX && text[length - 1] == '\r')
+            length--;
+
+        appendLocked(ring, text, length);
+        p = newline + 1;
+    }
+    pthread_mutex_unlock(&ring->Lock);
+}
+
+static int openInput(const LineRing *ring)
+{
+    if (!ring->Path)
+        return STDIN_FILENO;
+
+    /* Non-blocking open so a FIFO without writer does not hang lineRingStop() */
+    int fd = open(ring->Path, O_RDONLY | O_NONBLOCK);
+    if (fd < 0)
+        fprintf(stderr, "ERROR::LINERING: Failed to open %s: %s\n", ring->Path, strerror(errno));
+    return fd;
+}
+
+static void *readerThread(void *arg)
+{
+    LineRing *ring = (LineRing *)arg;
+    PartialLine partial = {{0}, 0};
+    char *chunk = (char *)malloc(READ_CHUNK);
+    int fd = chunk ? openInput(ring) : -1;
+
+    struct stat info;
+    int isFifo = fd >= 0 && fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode) && ring->Path;
+
+    while (fd >= 0 && atomic_load(&ring->Running))
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, POLL_TIMEOUT_MS);
+        if (ready < 0 && errno != EINTR)
+            break;
+        if (ready <= 0)
+            continue;
+
+        ssize_t size = read(fd, chunk, READ_CHUNK);
+        if (size > 0)
+        {
+            appendChunk(ring, &partial, chunk, (int)size);
+            continue;
+        }
+        if (size < 0 && (errno == EAGAIN || errno == EINTR))
+            continue;
+
+        /* End of input: a FIFO waits for its next writer */
+        if (size == 0 && isFifo)
+        {
+            close(fd);
+            fd = openInput(ring);
+            continue;
+        }
+        break;
+    }
+
+    /* Last line without a newline */
+    if (partial.Length > 0)
+        lineRingPush(ring, partial.Text, partial.Length);
+
+    if (fd > STDIN_FILENO)
+        close(fd);
+    free(chunk);
+    atomic_store(&ring->Finished, 1);
+    return NULL;
+}
+
+int lineRingStart(LineRing *ring, const char *path)
+{
+    ring->Path = path;
+    atomic_store(&ring->Running, 1);
+    if (pthread_create(&ring->Thread, NULL, readerThread, ring) != 0)
+    {
+        fprintf(stderr, "ERROR::LINERING: Failed to start reader thread\n");
+        atomic_store(&ring->Running, 0);
+        return 0;
+    }
+    ring->Started = 1;
+    return 1;
+}
+
+void lineRingStop(LineRing *ring)
+{
+    if (!ring->Started)
+        return;
+
+    atomic_store(&ring->Running, 0);
+    pthread_mutex_lock(&ring->Lock);
+    pthread_cond_broadcast(&ring->NotFull);
+    pthread_mutex_unlock(&ring->Lock);
+
+    pthread_join(ring->Thread, NULL);
+    ring->Started = 0;
+}
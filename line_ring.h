@@ -0,0 +1,83 @@
+#ifndef LINE_RING_H
+#define LINE_RING_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/*
+ * Fixed-size ring buffer of text lines fed by a reader thread.
+ *
+ * The reader thread pulls a file descriptor (stdin or a FIFO) in large
+ * chunks, splits them into lines and appends a whole chunk at a time under
+ * the ring's lock.  Line n lives in slot n % Capacity, so appending never
+ * allocates.  The consumer (the render loop) looks at the ring once per
+ * frame between lineRingAcquire() and lineRingRelease(), copies the few
+ * lines it needs and lets go.
+ *
+ * When the consumer falls more than Capacity lines behind, the ring either
+ * overwrites the oldest unseen lines and counts them as dropped, or, in
+ * blocking mode, stops reading so that the writer of the pipe blocks
+ * (back-pressure) and counts a stall.
+ */
+
+#define LINE_RING_LINE_MAX 256 /* Longer lines are truncated */
+
+typedef struct
+{
+    unsigned long long Lines;     /* Lines appended since the start */
+    unsigned long long Bytes;     /* Bytes read from the input */
+    unsigned long long Dropped;   /* Overwritten before the consumer looked at them */
+    unsigned long long Truncated; /* Lines cut at LINE_RING_LINE_MAX */
+    unsigned long long Stalls;    /* Times the reader waited for the consumer */
+    unsigned long long Pending;   /* Lines appended since the last lineRingAcquire(), at the time of the snapshot */
+} LineRingStats;
+
+typedef struct
+{
+    char *Text;             /* Capacity slots of LINE_RING_LINE_MAX bytes */
+    unsigned short *Length; /* Bytes used in each slot */
+    int Capacity;           /* Power of two */
+    int Blocking;
+
+    pthread_mutex_t Lock;
+    pthread_cond_t NotFull;
+    unsigned long long Head;     /* Sequence number of the next line */
+    unsigned long long Consumed; /* Head at the last lineRingAcquire() */
+    LineRingStats Stats;
+
+    /* Reader thread */
+    const char *Path; /* NULL reads stdin */
+    pthread_t Thread;
+    atomic_int Running;
+    atomic_int Finished; /* Input reached end of file */
+    int Started;
+} LineRing;
+
+/* capacity is rounded up to a power of two */
+int lineRingInit(LineRing *ring, int capacity, int blocking);
+void lineRingDestroy(LineRing *ring);
+
+/*
+ * Start the reader thread on path (a FIFO or regular file), or stdin when
+ * path is NULL.  A FIFO is reopened when its writer goes away.
+ */
+int lineRingStart(LineRing *ring, const char *path);
+void lineRingStop(LineRing *ring);
+
+/* Append one line (without the newline), used by the reader thread */
+void lineRingPush(LineRing *ring, const char *text, int length);
+
+/*
+ * Lock the ring and return the sequence number after the newest line.
+ * Everything before it counts as seen.  Call lineRingRelease() soon after.
+ */
+unsigned long long lineRingAcquire(LineRing *ring);
+void lineRingRelease(LineRing *ring);
+
+/* Line seq while acquired, NULL when it was overwritten or not written yet */
+const char *lineRingLine(const LineRing *ring, unsigned long long seq, int *length);
+
+/* Counter snapshot, safe to call from any thread */
+void lineRingGetStats(LineRing *ring, LineRingStats *stats);
+
+#endif /* LINE_RING_H */
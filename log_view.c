@@ -0,0 +1,190 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "log_view.h"
+
+#define PENDING_STRIDE (LINE_RING_LINE_MAX + 1)
+
+/* Tallest ascent and descent of the glyphs in the atlas */
+static void atlasExtent(const GlyphAtlas *atlas, int *ascent, int *descent)
+{
+    *ascent = 0;
+    *descent = 0;
+    for (int i = 0; i < atlas->Capacity; i++)
+    {
+        const AtlasGlyph *glyph = &atlas->Glyphs[i];
+        if (!glyph->Used)
+            continue;
+        if (glyph->Top > *ascent)
+            *ascent = glyph->Top;
+        if (glyph->Height - glyph->Top > *descent)
+            *descent = glyph->Height - glyph->Top;
+    }
+}
+
+int logViewInit(LogView *view, const TextRenderer *renderer, float x, float y, float height,
+                int columns, float scale, float r, float g, float b)
+{
+    memset(view, 0, sizeof(*view));
+    view->Renderer = renderer;
+    view->X = x;
+    view->Y = y;
+    view->Columns = columns;
+    view->Scale = scale;
+    view->R = r;
+    view->G = g;
+    view->B = b;
+
+    int ascent, descent;
+    atlasExtent(renderer->Atlas, &ascent, &descent);
+    view->Ascent = ascent * scale;
+    view->LineHeight = (ascent + descent) * scale + 2.0f;
+
+    int rows = (int)(height / view->LineHeight);
+    view->Rows = rows = rows > 0 ? rows : 1;
+
+    view->SlotLine = (unsigned long long *)calloc(rows, sizeof(unsigned long long));
+    view->SlotCount = (GLsizei *)calloc(rows, sizeof(GLsizei));
+    view->First = (GLint *)malloc(rows * sizeof(GLint));
+    view->Count = (GLsizei *)malloc(rows * sizeof(GLsizei));
+    view->Pending = (char *)malloc((size_t)rows * PENDING_STRIDE);
+    view->PendingLine = (unsigned long long *)malloc(rows * sizeof(unsigned long long));
+    drawListInit(&view->Staging);
+    if (!view->SlotLine || !view->SlotCount || !view->First || !view->Count ||
+        !view->Pending || !view->PendingLine || !drawListReserve(&view->Staging, 6 * LINE_RING_LINE_MAX))
+    {
+        fprintf(stderr, "ERROR::LOGVIEW: Failed to allocate %d rows\n", rows);
+        logViewDestroy(view); /* No GL objects yet, deleting name 0 is a no-op */
+        return 0;
+    }
+
+    /* Every slot has room for a full line, the store never changes size */
+    glGenBuffers(1, &view->VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, view->VBO);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)rows * columns * 6 * sizeof(TextVertex), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    view->VAO = textRendererCreateBufferVAO(view->VBO);
+    return 1;
+}
+
+void logViewDestroy(LogView *view)
+{
+    glDeleteVertexArrays(1, &view->VAO);
+    glDeleteBuffers(1, &view->VBO);
+    free(view->SlotLine);
+    free(view->SlotCount);
+    free(view->First);
+    free(view->Count);
+    free(view->Pending);
+    free(view->PendingLine);
+    drawListFree(&view->Staging);
+    memset(view, 0, sizeof(*view));
+}
+
+/* Decode and lay out one line into its slot and upload it */
+static void layoutLine(LogView *view, unsigned long long line, const char *text)
+{
+    int slot = (int)(line % view->Rows);
+    float baseline = slot * view->LineHeight + view->Ascent;
+
+    drawListClear(&view->Staging);
+    layoutText(&view->Staging, view->Renderer->Atlas, text, view->X, baseline, view->Scale,
+               view->R, view->G, view->B);
+
+    int count = view->Staging.Count;
+    if (count > view->Columns * 6)
+        count = view->Columns * 6;
+
+    GLsizeiptr slotBytes = (GLsizeiptr)view->Columns * 6 * sizeof(TextVertex);
+    if (count > 0)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, view->VBO);
+        glBufferSubData(GL_ARRAY_BUFFER, slot * slotBytes, count * sizeof(TextVertex), view->Staging.Vertices);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        view->LastUploadBytes += count * sizeof(TextVertex);
+    }
+
+    view->SlotLine[slot] = line + 1;
+    view->SlotCount[slot] = count;
+}
+
+void logViewUpdate(LogView *view, LineRing *ring)
+{
+    view->LastDecoded = 0;
+    view->LastReused = 0;
+    view->LastUploadBytes = 0;
+
+    /* 每帧只取一次：这期间到达的所有行合并成一次更新 */
+    unsigned long long head = lineRingAcquire(ring);
+    unsigned long long first = head > (unsigned long long)view->Rows ? head - view->Rows : 0;
+
+    int pending = 0;
+    for (unsigned long long line = first; line < head; line++)
+    {
+        if (view->SlotLine[line % view->Rows] == line + 1)
+        {
+            view->LastReused++;
+            continue;
+        }
+
+        /* Copy the text out, decoding happens after the ring is released */
+        int length = 0;
+        const char *text = lineRingLine(ring, line, &length);
+        char *copy = view->Pending + (size_t)pending * PENDING_STRIDE;
+        if (text)
+            memcpy(copy, text, length);
+        copy[text ? length : 0] = '\0';
+        view->PendingLine[pending++] = line;
+    }
+    lineRingRelease(ring);
+
+    for (int i = 0; i < pending; i++)
+        layoutLine(view, view->PendingLine[i], view->Pending + (size_t)i * PENDING_STRIDE);
+
+    if (first > view->Head)
+        view->Skipped += first - view->Head;
+    if (head > view->Head)
+        view->Head = head;
+
+    view->LastDecoded = pending;
+    view->Decoded += pending;
+    view->Reused += view->LastReused;
+}
+
+void logViewDraw(LogView *view, float viewportWidth, float viewportHeight)
+{
+    unsigned long long head = view->Head;
+    unsigned long long first = head > (unsigned long long)view->Rows ? head - view->Rows : 0;
+    int shown = (int)(head - first);
+    if (shown == 0)
+        return;
+
+    /*
+     * Slots follow the rows except at the wrap, so the lines split into at
+     * most two runs; within a run one projection offset puts every slot on
+     * its row.
+     */
+    GLint *firstVertex = view->First;
+    GLsizei *count = view->Count;
+    int runStart = 0;
+    for (int row = 0; row <= shown; row++)
+    {
+        int slot = row < shown ? (int)((first + row) % view->Rows) : 0;
+        if (row > runStart && (row == shown || slot == 0))
+        {
+            int startSlot = (int)((first + runStart) % view->Rows);
+            float offset = (startSlot - runStart) * view->LineHeight - view->Y;
+            textRendererSetView(view->Renderer, 0.0f, offset, viewportWidth, viewportHeight);
+            textRendererDrawRanges(view->Renderer, view->VAO, firstVertex + runStart, count + runStart,
+                                   row - runStart);
+            runStart = row;
+        }
+        if (row < shown)
+        {
+            firstVertex[row] = slot * view->Columns * 6;
+            count[row] = view->SlotCount[slot];
+        }
+    }
+
+    textRendererSetViewport(view->Renderer, viewportWidth, viewportHeight);
+}
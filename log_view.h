@@ -0,0 +1,69 @@
+#ifndef LOG_VIEW_H
+#define LOG_VIEW_H
+
+#include <GL/glew.h>
+#include "line_ring.h"
+#include "text_layout.h"
+#include "text_renderer.h"
+
+/*
+ * Streaming log view: the tail of a LineRing, newest line at the bottom.
+ *
+ * Line n is laid out once, into slot n % Rows of the view's own vertex
+ * buffer at y = slot * LineHeight.  When new lines push the old ones up, the
+ * old geometry stays where it is and only the projection moves (at most
+ * two glMultiDrawArrays() calls, one on each side of the slot wrap).
+ * logViewUpdate() runs once per frame: however many lines arrived since
+ * the last frame, only the ones that end up on screen and are not resident
+ * yet are decoded, laid out and uploaded.
+ *
+ * The vertex array object belongs to the context that was current in
+ * logViewInit().
+ */
+
+typedef struct
+{
+    const TextRenderer *Renderer;
+    GLuint VBO;
+    GLuint VAO;
+
+    float X, Y; /* Top-left corner in pixels */
+    float Scale;
+    float R, G, B; /* 0-255 */
+    float LineHeight, Ascent;
+    int Rows;    /* Lines on screen, also the number of slots */
+    int Columns; /* Glyphs kept per line */
+
+    unsigned long long *SlotLine; /* Line number + 1 held by each slot, 0 when empty */
+    GLsizei *SlotCount;           /* Vertices of each slot */
+    GLint *First;                 /* Draw ranges, one per row */
+    GLsizei *Count;
+
+    /* Lines to lay out this frame, copied out of the ring */
+    char *Pending; /* Rows * (LINE_RING_LINE_MAX + 1) */
+    unsigned long long *PendingLine;
+    DrawList Staging;
+
+    unsigned long long Head; /* Lines before Head have been shown or skipped */
+
+    /* Counters since logViewInit(), the Last* ones for the last update */
+    unsigned long long Decoded; /* Lines decoded and laid out */
+    unsigned long long Reused;  /* Visible lines drawn from resident geometry */
+    unsigned long long Skipped; /* Lines that scrolled past between two frames */
+    int LastDecoded;
+    int LastReused;
+    long LastUploadBytes;
+} LogView;
+
+/* As many rows as fit into height pixels, lines cut after columns glyphs */
+int logViewInit(LogView *view, const TextRenderer *renderer, float x, float y, float height,
+                int columns, float scale, float r, float g, float b);
+void logViewDestroy(LogView *view);
+
+/* Pull the newest lines from the ring, once per frame */
+void logViewUpdate(LogView *view, LineRing *ring);
+
+/* Draw the visible lines; the renderer's projection is restored to the viewport afterwards */
+void logViewDraw(LogView *view, float viewportWidth, float viewportHeight);
+
+#endif /* LOG_VIEW_H */
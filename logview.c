@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "line_ring.h"
+#include "log_view.h"
+#include "text_object.h"
+#include "text_renderer.h"
+
+/*
+ * 实时日志窗口
+ *
+ * 读取线程把标准输入（或一个 FIFO）按行写进环形缓冲区，渲染循环每帧只取
+ * 一次最新状态，显示末尾的若干行。已经排好版的行滚动时不再解码，只有新出现
+ * 在屏幕上的行才会经过 codepoint_from_utf8 和排版。顶部一行显示吞吐量、
+ * 丢弃和背压计数。
+ *
+ *     some-command | LogView
+ *     LogView /path/to/fifo [--block]
+ *
+ * 默认在渲染跟不上时覆盖最旧的行并计入 dropped；--block 则暂停读取，让写端
+ * 阻塞在管道上。
+ */
+
+/* Window dimensions */
+const GLuint WIDTH = 1024, HEIGHT = 768;
+
+#define ATLAS_SIZE 512
+#define RING_LINES 65536
+#define LOG_COLUMNS 160
+#define STATUS_HEIGHT 32.0f
+
+FontRegistry fonts;
+GlyphAtlas atlas;
+TextRenderer textRenderer;
+LineRing ring;
+LogView logView;
+TextObject status;
+
+/* Function prototypes */
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+void initFreeType(void);
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    int blocking = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--block") == 0)
+            blocking = 1;
+        else
+            path = argv[i];
+    }
+
+    /* Initialize GLFW */
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return -1;
+    }
+
+    /* Set OpenGL version and profile */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+
+    /* Create a windowed mode window and its OpenGL context */
+    GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Log View", NULL, NULL);
+    if (!window)
+    {
+        fprintf(stderr, "Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    /* Set callback functions */
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+
+    /* Initialize GLEW */
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    initFreeType();
+
+    textRendererInit(&textRenderer, &atlas);
+    textRendererSetViewport(&textRenderer, (float)WIDTH, (float)HEIGHT);
+
+    /* Input starts flowing as soon as the reader thread runs */
+    if (!lineRingInit(&ring, RING_LINES, blocking))
+        return -1;
+    if (!lineRingStart(&ring, path))
+    {
+        lineRingDestroy(&ring);
+        return -1;
+    }
+
+    textObjectInit(&status, &textRenderer, 8.0f, 22.0f, 1.0f, 255, 215, 0);
+    if (!logViewInit(&logView, &textRenderer, 8.0f, STATUS_HEIGHT, HEIGHT - STATUS_HEIGHT,
+                     LOG_COLUMNS, 1.0f, 220, 220, 220))
+    {
+        /* Stop the reader thread before its ring goes away */
+        textObjectDestroy(&status);
+        lineRingDestroy(&ring);
+        return -1;
+    }
+
+    /* Enable blending for text rendering */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    LineRingStats stats, lastStats;
+    memset(&lastStats, 0, sizeof(lastStats));
+    double lastTime = glfwGetTime(), rate = 0.0;
+    int statFrames = 0;
+    long statDecoded = 0, statReused = 0, statUpload = 0;
+
+    /* Main loop */
+    while (!glfwWindowShouldClose(window))
+    {
+        /* Clear the screen */
+        glClearColor(0.1f, 0.1f, 0.12f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        logViewUpdate(&logView, &ring);
+        statDecoded += logView.LastDecoded;
+        statReused += logView.LastReused;
+        statUpload += logView.LastUploadBytes;
+        statFrames++;
+
+        double t = glfwGetTime();
+        if (t - lastTime >= 2.0)
+        {
+            lineRingGetStats(&ring, &stats);
+            rate = (stats.Lines - lastStats.Lines) / (t - lastTime);
+            printf("%.0f lines/s  dropped %llu  truncated %llu  stalls %llu  "
+                   "per frame: decoded %ld reused %ld upload %ld bytes  skipped %llu\n",
+                   rate, stats.Dropped, stats.Truncated, stats.Stalls,
+                   statDecoded / statFrames, statReused / statFrames, statUpload / statFrames,
+                   logView.Skipped);
+            lastStats = stats;
+            lastTime = t;
+            statFrames = 0;
+            statDecoded = statReused = statUpload = 0;
+        }
+
+        /* 状态行只有数字在变，增量上传 */
+        lineRingGetStats(&ring, &stats);
+        textObjectPrintf(&status, "%s %.0f lines/s | total %llu | dropped %llu | stalls %llu | truncated %llu",
+                         atomic_load(&ring.Finished) ? "EOF" : "LIVE", rate,
+                         stats.Lines, stats.Dropped, stats.Stalls, stats.Truncated);
+
+        textObjectDraw(&status);
+        logViewDraw(&logView, (float)WIDTH, (float)HEIGHT);
+
+        /* Swap front and back buffers */
+        glfwSwapBuffers(window);
+
+        /* Poll for and process events */
+        glfwPollEvents();
+    }
+
+    /* Clean up */
+    lineRingStop(&ring);
+    logViewDestroy(&logView);
+    textObjectDestroy(&status);
+    lineRingDestroy(&ring);
+    textRendererDestroy(&textRenderer);
+    glyphAtlasDestroy(&atlas);
+
+    /* Terminate GLFW */
+    glfwTerminate();
+
+    return 0;
+}
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GL_TRUE);
+}
+
+void initFreeType(void)
+{
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    /* Index installed fonts (cached on disk) and map the best match */
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+
+    /* 等宽字体优先，日志按列对齐 */
+    FT_Face face;
+    const char *fontFamilies[] = {"DejaVu Sans Mono", "Liberation Mono", "Consolas", "Menlo", "Courier New", "FreeMono",
+                                  "DejaVu Sans", "Arial"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(ft);
+        exit(1);
+    }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+
+    /* Rasterize at the size the lines are drawn at */
+    FT_Set_Pixel_Sizes(face, 0, 16);
+
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        exit(1);
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+
+    /* Clean up FreeType resources, the face reads from the registry's mapping */
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+}
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "text_renderer.h"
+
+/*
+ * 多窗口共享字形图集
+ *
+ * 第一个窗口创建的上下文持有着色器程序、VBO 和图集纹理，其余窗口在创建时把
+ * 第一个窗口作为 share 参数传入 glfwCreateWindow，因此这些对象只创建一次、
+ * 字形只光栅化一次。VAO 不能在上下文之间共享，所以每个窗口各自创建一个。
+ */
+
+/* Window dimensions */
+const GLuint WIDTH = 640, HEIGHT = 360;
+
+#define MAX_WINDOWS 8
+#define ATLAS_SIZE 512
+
+typedef struct
+{
+    GLFWwindow *Window;
+    GLuint VAO; /* Per context, VAOs are not shared */
+    int Width;
+    int Height;
+} TextWindow;
+
+TextWindow windows[MAX_WINDOWS];
+int numWindows = 3;
+
+FontRegistry fonts; /* Owns the font file mappings */
+GlyphAtlas atlas;
+TextRenderer textRenderer;
+
+/* Function prototypes */
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+FT_Face initFreeType(FT_Library *ft);
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        numWindows = atoi(argv[1]);
+        if (numWindows < 1)
+            numWindows = 1;
+        if (numWindows > MAX_WINDOWS)
+            numWindows = MAX_WINDOWS;
+    }
+
+    /* Initialize GLFW */
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return -1;
+    }
+
+    /* Set OpenGL version and profile */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    /* Create all windows, every context after the first shares with it */
+    for (int i = 0; i < numWindows; i++)
+    {
+        char title[64];
+        snprintf(title, sizeof(title), "Shared Atlas #%d", i + 1);
+
+        GLFWwindow *share = i > 0 ? windows[0].Window : NULL;
+        windows[i].Window = glfwCreateWindow(WIDTH, HEIGHT, title, NULL, share);
+        if (!windows[i].Window)
+        {
+            fprintf(stderr, "Failed to create GLFW window %d\n", i + 1);
+            glfwTerminate();
+            return -1;
+        }
+
+        windows[i].Width = WIDTH;
+        windows[i].Height = HEIGHT;
+        glfwSetWindowUserPointer(windows[i].Window, &windows[i]);
+        glfwSetWindowPos(windows[i].Window, 40 + i * 60, 40 + i * 60);
+        glfwSetFramebufferSizeCallback(windows[i].Window, framebuffer_size_callback);
+        glfwSetKeyCallback(windows[i].Window, key_callback);
+    }
+
+    /* Initialize GLEW with the first context current */
+    glfwMakeContextCurrent(windows[0].Window);
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    /* Rasterize once into the shared atlas */
+    FT_Library ft;
+    FT_Face face = initFreeType(&ft);
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        return -1;
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+
+    /* Program, VBO and atlas texture live in the share group */
+    textRendererInit(&textRenderer, &atlas);
+    printf("Shared atlas: %d glyphs, %d KiB texture for %d windows\n",
+           atlas.Count, atlas.Width * atlas.Height / 1024, numWindows);
+
+    /* Per context state: VAO and blending */
+    for (int i = 0; i < numWindows; i++)
+    {
+        glfwMakeContextCurrent(windows[i].Window);
+        windows[i].VAO = textRendererCreateVAO(&textRenderer);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    /* Main loop */
+    int openWindows = numWindows;
+    while (openWindows > 0)
+    {
+        for (int i = 0; i < numWindows; i++)
+        {
+            TextWindow *tw = &windows[i];
+            if (!tw->Window)
+                continue;
+
+            glfwMakeContextCurrent(tw->Window);
+
+            if (glfwWindowShouldClose(tw->Window))
+            {
+                /* The VAO belongs to this context, delete it before the context goes away */
+                glDeleteVertexArrays(1, &tw->VAO);
+                if (openWindows == 1)
+                    textRendererDestroy(&textRenderer);
+                glfwDestroyWindow(tw->Window);
+                tw->Window = NULL;
+                openWindows--;
+                continue;
+            }
+
+            glViewport(0, 0, tw->Width, tw->Height);
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            /* Projection is program state, set it for this window's size */
+            textRendererSetViewport(&textRenderer, (float)tw->Width, (float)tw->Height);
+
+            char text[64];
+            snprintf(text, sizeof(text), "Hello Window #%d", i + 1);
+            float scale = 1.0f;
+            float x = (tw->Width - textRendererMeasure(&textRenderer, text, scale)) / 2.0f;
+            float y = tw->Height / 2.0f;
+
+            textRendererDraw(&textRenderer, tw->VAO, text, x, y - 60, scale, 0, 0, 0);
+            textRendererDraw(&textRenderer, tw->VAO, text, x, y, scale, -1, -1, -1);
+            textRendererDraw(&textRenderer, tw->VAO, text, x, y + 60, scale, 255, 215, 0);
+
+            /* Swap front and back buffers */
+            glfwSwapBuffers(tw->Window);
+        }
+
+        /* Poll for and process events */
+        glfwPollEvents();
+    }
+
+    glyphAtlasDestroy(&atlas);
+
+    /* Terminate GLFW */
+    glfwTerminate();
+
+    return 0;
+}
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+    TextWindow *tw = (TextWindow *)glfwGetWindowUserPointer(window);
+    tw->Width = width;
+    tw->Height = height;
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GL_TRUE);
+}
+
+FT_Face initFreeType(FT_Library *ft)
+{
+    if (FT_Init_FreeType(ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+
+    /* Index installed fonts (cached on disk) and map the best match */
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, *ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(*ft);
+        exit(1);
+    }
+
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+    FT_Set_Pixel_Sizes(face, 0, 48);
+    return face;
+}
@@ -0,0 +1,317 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "text_layout.h"
+#include "text_renderer.h"
+#include "spsc_queue.h"
+
+/*
+ * 布局线程与 GL 提交线程的流水线
+ *
+ * 布局线程负责字符串测量、UTF-8 解码、排版和彩虹颜色生成，把第 N+1 帧的
+ * 顶点写进一个 DrawList；主线程只做 GL 调用、交换缓冲和事件处理，同时提交
+ * 第 N 帧。两个线程之间用两个无锁 SPSC 队列交换 Frame：ready 队列把排好的
+ * 帧交给主线程，free 队列把用完的帧还给布局线程。Frame 一旦入队就不再修改，
+ * 帧池的大小限制了流水线深度。流水线满时布局线程在 freeCond 上等待，主线程
+ * 归还帧后唤醒它。
+ */
+
+/* Window dimensions */
+const GLuint WIDTH = 800, HEIGHT = 600;
+
+#define ATLAS_SIZE 512
+#define FRAME_POOL 3 /* Frames in flight, must not exceed SPSC_CAPACITY */
+
+typedef struct
+{
+    DrawList List;
+    unsigned long Number; /* Frame counter set by the layout thread */
+    double LayoutTime;    /* Seconds spent building List */
+} Frame;
+
+Frame frames[FRAME_POOL];
+SpscQueue readyFrames; /* Layout thread -> GL thread */
+SpscQueue freeFrames;  /* GL thread -> layout thread */
+pthread_mutex_t freeLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t freeCond = PTHREAD_COND_INITIALIZER; /* Signalled when freeFrames gains a frame */
+atomic_int running = 1;
+
+FontRegistry fonts; /* Owns the font file mappings */
+GlyphAtlas atlas;
+TextRenderer textRenderer;
+GLuint VAO;
+int stressLines = 200;
+
+/* Function prototypes */
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+FT_Face initFreeType(FT_Library *ft);
+void *layoutThread(void *arg);
+void releaseFrame(Frame *frame);
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        stressLines = atoi(argv[1]);
+
+    /* Initialize GLFW */
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return -1;
+    }
+
+    /* Set OpenGL version and profile */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    /* Create a windowed mode window and its OpenGL context */
+    GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Pipelined Text", NULL, NULL);
+    if (!window)
+    {
+        fprintf(stderr, "Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    /* Set callback functions */
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+
+    /* Initialize GLEW */
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    /* The atlas must be complete before the layout thread starts reading it */
+    FT_Library ft;
+    FT_Face face = initFreeType(&ft);
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        return -1;
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+
+    textRendererInit(&textRenderer, &atlas);
+    VAO = textRendererCreateVAO(&textRenderer);
+    textRendererSetViewport(&textRenderer, (float)WIDTH, (float)HEIGHT);
+
+    /* Enable blending for text rendering */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    /* All frames start out owned by the layout thread */
+    spscInit(&readyFrames);
+    spscInit(&freeFrames);
+    for (int i = 0; i < FRAME_POOL; i++)
+    {
+        drawListInit(&frames[i].List);
+        spscPush(&freeFrames, &frames[i]);
+    }
+
+    pthread_t layout;
+    if (pthread_create(&layout, NULL, layoutThread, NULL) != 0)
+    {
+        fprintf(stderr, "Failed to start layout thread\n");
+        return -1;
+    }
+
+    Frame *current = NULL;
+    unsigned long expected = 0;
+    int statFrames = 0, statProduced = 0;
+    double statLayout = 0.0, statSubmit = 0.0, statStart = glfwGetTime();
+
+    /* Main loop: GL work only */
+    while (!glfwWindowShouldClose(window))
+    {
+        /* Take the next finished frame in order, return the one just shown */
+        Frame *ready = (Frame *)spscPop(&readyFrames);
+        if (ready)
+        {
+            if (ready->Number != expected)
+                fprintf(stderr, "ERROR::PIPELINE: Frame %lu arrived, expected %lu\n", ready->Number, expected);
+            expected = ready->Number + 1;
+            if (current)
+                releaseFrame(current);
+            current = ready;
+            statLayout += ready->LayoutTime;
+            statProduced++;
+        }
+
+        double submitStart = now();
+
+        /* Clear the screen */
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        if (current)
+            textRendererSubmit(&textRenderer, VAO, &current->List);
+
+        /* Swap front and back buffers */
+        glfwSwapBuffers(window);
+        statSubmit += now() - submitStart;
+        statFrames++;
+
+        /* Poll for and process events */
+        glfwPollEvents();
+
+        double elapsed = glfwGetTime() - statStart;
+        if (elapsed >= 2.0 && statProduced > 0)
+        {
+            printf("frames %d  layout %.3f ms  submit %.3f ms  frame %.3f ms\n",
+                   statFrames,
+                   1000.0 * statLayout / statProduced,
+                   1000.0 * statSubmit / statFrames,
+                   1000.0 * elapsed / statFrames);
+            statFrames = statProduced = 0;
+            statLayout = statSubmit = 0.0;
+            statStart = glfwGetTime();
+        }
+    }
+
+    /* Stop the producer before tearing down what it reads */
+    atomic_store(&running, 0);
+    pthread_mutex_lock(&freeLock);
+    pthread_cond_broadcast(&freeCond);
+    pthread_mutex_unlock(&freeLock);
+    pthread_join(layout, NULL);
+
+    /* Clean up */
+    for (int i = 0; i < FRAME_POOL; i++)
+        drawListFree(&frames[i].List);
+    glDeleteVertexArrays(1, &VAO);
+    textRendererDestroy(&textRenderer);
+    glyphAtlasDestroy(&atlas);
+
+    /* Terminate GLFW */
+    glfwTerminate();
+
+    return 0;
+}
+
+/* Hand a shown frame back to the layout thread and wake it if it waits */
+void releaseFrame(Frame *frame)
+{
+    spscPush(&freeFrames, frame);
+    pthread_mutex_lock(&freeLock);
+    pthread_cond_signal(&freeCond);
+    pthread_mutex_unlock(&freeLock);
+}
+
+/* Producer: builds draw lists without touching GL */
+void *layoutThread(void *arg)
+{
+    unsigned long number = 0;
+    char line[128];
+
+    while (atomic_load(&running))
+    {
+        Frame *frame = (Frame *)spscPop(&freeFrames);
+        if (!frame)
+        {
+            /* GL thread still holds every frame, pipeline is full.  The pop is
+             * retried under the lock so a release between the two is not lost. */
+            pthread_mutex_lock(&freeLock);
+            while (atomic_load(&running) && !(frame = (Frame *)spscPop(&freeFrames)))
+                pthread_cond_wait(&freeCond, &freeLock);
+            pthread_mutex_unlock(&freeLock);
+            if (!frame)
+                break;
+        }
+
+        double start = now();
+        DrawList *list = &frame->List;
+        drawListClear(list);
+
+        /* 渲染居中文本 */
+        const char *text = "Hello World!";
+        float scale = 1.5f;
+        float x = (WIDTH - measureText(&atlas, text, scale)) / 2.0f;
+        float y = HEIGHT / 2.0f;
+
+        layoutText(list, &atlas, text, x, y - 100, scale, 0, 0, 0);     // 黑色
+        layoutText(list, &atlas, text, x, y, scale, -1, -1, -1);        // 彩虹模式
+        layoutText(list, &atlas, text, x, y + 100, scale, 255, 215, 0); // 金色
+
+        /* Background load so layout cost is measurable */
+        for (int i = 0; i < stressLines; i++)
+        {
+            snprintf(line, sizeof(line), "frame %lu line %d: the quick brown fox jumps over the lazy dog",
+                     number, i);
+            layoutText(list, &atlas, line, 4.0f, 12.0f + (i % 50) * 12.0f, 0.25f, 200, 200, 200);
+        }
+
+        frame->Number = number++;
+        frame->LayoutTime = now() - start;
+
+        /* Cannot fail, the pool is smaller than the queue */
+        spscPush(&readyFrames, frame);
+    }
+
+    return NULL;
+}
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GL_TRUE);
+}
+
+FT_Face initFreeType(FT_Library *ft)
+{
+    if (FT_Init_FreeType(ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+
+    /* Index installed fonts (cached on disk) and map the best match */
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, *ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(*ft);
+        exit(1);
+    }
+
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+    FT_Set_Pixel_Sizes(face, 0, 48);
+    return face;
+}
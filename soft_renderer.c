@@ -0,0 +1,411 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "soft_renderer.h"
+
+/* SOFT_RENDER_SCALAR forces the portable loop, the tests compare it with the SIMD ones */
+#if defined(SOFT_RENDER_SCALAR)
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define SOFT_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SOFT_SSE2 1
+#endif
+
+/* Rows per band handed to one worker at a time */
+#define BAND_HEIGHT 32
+#define MAX_THREADS 64
+
+int softTargetCreate(SoftTarget *target, int width, int height)
+{
+    target->Width = width;
+    target->Height = height;
+    target->Stride = width * 4;
+    target->Pixels = (unsigned char *)calloc((size_t)target->Stride * height, 1);
+    if (!target->Pixels)
+    {
+        fprintf(stderr, "ERROR::SOFT: Failed to allocate %dx%d target\n", width, height);
+        return 0;
+    }
+    return 1;
+}
+
+void softTargetDestroy(SoftTarget *target)
+{
+    free(target->Pixels);
+    memset(target, 0, sizeof(*target));
+}
+
+/* Float to unorm8 like the GL: nearest, ties to even (0.3 -> 76, not 77) */
+static unsigned char toByte(float value)
+{
+    if (value <= 0.0f)
+        return 0;
+    if (value >= 1.0f)
+        return 255;
+    return (unsigned char)lrintf(value * 255.0f);
+}
+
+void softTargetClear(SoftTarget *target, float r, float g, float b, float a)
+{
+    unsigned char pixel[4] = {toByte(r), toByte(g), toByte(b), toByte(a)};
+
+    for (int y = 0; y < target->Height; y++)
+    {
+        unsigned char *row = target->Pixels + (size_t)y * target->Stride;
+        for (int x = 0; x < target->Width; x++)
+            memcpy(row + 4 * x, pixel, 4);
+    }
+}
+
+int softTargetWritePPM(const SoftTarget *target, const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return 0;
+
+    fprintf(file, "P6\n%d %d\n255\n", target->Width, target->Height);
+    for (int y = 0; y < target->Height; y++)
+    {
+        const unsigned char *row = target->Pixels + (size_t)y * target->Stride;
+        for (int x = 0; x < target->Width; x++)
+            fwrite(row + 4 * x, 1, 3, file);
+    }
+
+    return fclose(file) == 0;
+}
+
+const char *softRenderBackendName(void)
+{
+#if defined(SOFT_AVX2)
+    return "avx2";
+#elif defined(SOFT_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+/* ---- Blending ---- */
+
+/* x / 255 rounded, exact for 0 <= x <= 255 * 255 */
+static inline unsigned int div255(unsigned int x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/*
+ * dst = src * a + dst * (1 - a) per channel, where src = (r, g, b, a):
+ * the shader outputs alpha = coverage and the blend applies to alpha too.
+ */
+static void blendSpanScalar(unsigned char *dst, const unsigned char *coverage, int count,
+                            unsigned int r, unsigned int g, unsigned int b)
+{
+    for (int i = 0; i < count; i++, dst += 4)
+    {
+        unsigned int a = coverage[i];
+        if (a == 0)
+            continue;
+
+        unsigned int inv = 255 - a;
+        dst[0] = (unsigned char)div255(r * a + dst[0] * inv);
+        dst[1] = (unsigned char)div255(g * a + dst[1] * inv);
+        dst[2] = (unsigned char)div255(b * a + dst[2] * inv);
+        dst[3] = (unsigned char)div255(a * a + dst[3] * inv);
+    }
+}
+
+#if defined(SOFT_SSE2) || defined(SOFT_AVX2)
+/* div255 on eight 16-bit lanes */
+static inline __m128i div255x8(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/* Blend two pixels widened to 16-bit lanes */
+static inline __m128i blendHalf(__m128i src, __m128i alpha, __m128i dst)
+{
+    __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    return div255x8(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inv)));
+}
+#endif
+
+#if defined(SOFT_AVX2)
+static inline __m256i div255x16(__m256i x)
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+#endif
+
+static void blendSpan(unsigned char *dst, const unsigned char *coverage, int count,
+                      unsigned int r, unsigned int g, unsigned int b)
+{
+    int i = 0;
+
+#if defined(SOFT_AVX2)
+    /* 8 pixels per step */
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i full = _mm256_set1_epi16(255);
+    const __m256i color = _mm256_set1_epi32((int)(r | (g << 8) | (b << 16)));
+    const __m256i alphaLane = _mm256_set1_epi32((int)0xFF000000u);
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                            4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+    for (; i + 8 <= count; i += 8)
+    {
+        long long cov8;
+        memcpy(&cov8, coverage + i, 8);
+        if (cov8 == 0)
+            continue;
+
+        /* Replicate each coverage byte over the four channels of its pixel */
+        __m256i alpha = _mm256_shuffle_epi8(_mm256_set1_epi64x(cov8), spread);
+        __m256i src = _mm256_or_si256(color, _mm256_and_si256(alpha, alphaLane));
+
+        unsigned char *p = dst + 4 * i;
+        __m256i d = _mm256_loadu_si256((const __m256i *)p);
+
+        __m256i aLo = _mm256_unpacklo_epi8(alpha, zero);
+        __m256i aHi = _mm256_unpackhi_epi8(alpha, zero);
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(src, zero), aLo),
+                                      _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), _mm256_sub_epi16(full, aLo)));
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(src, zero), aHi),
+                                      _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), _mm256_sub_epi16(full, aHi)));
+
+        /* unpack/pack both work per 128-bit lane, so pixel order is kept */
+        _mm256_storeu_si256((__m256i *)p, _mm256_packus_epi16(div255x16(lo), div255x16(hi)));
+    }
+#endif
+
+#if defined(SOFT_SSE2) || defined(SOFT_AVX2)
+    /* 4 pixels per step */
+    const __m128i zero4 = _mm_setzero_si128();
+    const __m128i color4 = _mm_set1_epi32((int)(r | (g << 8) | (b << 16)));
+    const __m128i alphaLane4 = _mm_set1_epi32((int)0xFF000000u);
+    for (; i + 4 <= count; i += 4)
+    {
+        int cov4;
+        memcpy(&cov4, coverage + i, 4);
+        if (cov4 == 0)
+            continue;
+
+        __m128i alpha = _mm_cvtsi32_si128(cov4);
+        alpha = _mm_unpacklo_epi8(alpha, alpha);
+        alpha = _mm_unpacklo_epi16(alpha, alpha);
+        __m128i src = _mm_or_si128(color4, _mm_and_si128(alpha, alphaLane4));
+
+        unsigned char *p = dst + 4 * i;
+        __m128i d = _mm_loadu_si128((const __m128i *)p);
+
+        __m128i lo = blendHalf(_mm_unpacklo_epi8(src, zero4), _mm_unpacklo_epi8(alpha, zero4),
+                               _mm_unpacklo_epi8(d, zero4));
+        __m128i hi = blendHalf(_mm_unpackhi_epi8(src, zero4), _mm_unpackhi_epi8(alpha, zero4),
+                               _mm_unpackhi_epi8(d, zero4));
+        _mm_storeu_si128((__m128i *)p, _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    blendSpanScalar(dst + 4 * i, coverage + i, count - i, r, g, b);
+}
+
+/* ---- Quad rasterization ---- */
+
+/* a + (b - a) * w / 256, rounded */
+static inline int lerp8(int a, int b, int w)
+{
+    return a + (((b - a) * w + 128) >> 8);
+}
+
+/*
+ * Bilinear coverage at texel coordinates (tx, ty), clamp to edge like the GL
+ * texture.  The weights have 8 fractional bits, the subtexel precision GL
+ * implementations (llvmpipe among them) filter 8-bit textures with; exact
+ * float weights land up to two units away from them on steep glyph edges.
+ */
+static unsigned char sampleAtlas(const GlyphAtlas *atlas, float tx, float ty)
+{
+    tx -= 0.5f;
+    ty -= 0.5f;
+    int x0 = (int)floorf(tx), y0 = (int)floorf(ty);
+    int wx = (int)((tx - x0) * 256.0f + 0.5f), wy = (int)((ty - y0) * 256.0f + 0.5f);
+    int x1 = x0 + 1, y1 = y0 + 1;
+
+    x0 = x0 < 0 ? 0 : (x0 >= atlas->Width ? atlas->Width - 1 : x0);
+    x1 = x1 < 0 ? 0 : (x1 >= atlas->Width ? atlas->Width - 1 : x1);
+    y0 = y0 < 0 ? 0 : (y0 >= atlas->Height ? atlas->Height - 1 : y0);
+    y1 = y1 < 0 ? 0 : (y1 >= atlas->Height ? atlas->Height - 1 : y1);
+
+    const unsigned char *row0 = atlas->Pixels + (size_t)y0 * atlas->Width;
+    const unsigned char *row1 = atlas->Pixels + (size_t)y1 * atlas->Width;
+    int top = lerp8(row0[x0], row0[x1], wx);
+    int bottom = lerp8(row1[x0], row1[x1], wx);
+    return (unsigned char)lerp8(top, bottom, wy);
+}
+
+typedef struct
+{
+    float X0, Y0, X1, Y1; /* Screen rectangle */
+    float U0, V0, U1, V1; /* Atlas rectangle */
+    unsigned int R, G, B;
+} SoftQuad;
+
+static void quadFromVertices(const TextVertex *v, SoftQuad *quad)
+{
+    /* layoutText() emits top-left first and bottom-right third */
+    quad->X0 = v[0].X;
+    quad->Y0 = v[0].Y;
+    quad->U0 = v[0].U;
+    quad->V0 = v[0].V;
+    quad->X1 = v[2].X;
+    quad->Y1 = v[2].Y;
+    quad->U1 = v[2].U;
+    quad->V1 = v[2].V;
+    quad->R = toByte(v[0].R);
+    quad->G = toByte(v[0].G);
+    quad->B = toByte(v[0].B);
+}
+
+/* Composite the part of quad that falls into rows [rowStart, rowEnd) */
+static void drawQuad(SoftTarget *target, const GlyphAtlas *atlas, const SoftQuad *quad,
+                     int rowStart, int rowEnd, unsigned char *coverage)
+{
+    /*
+     * Pixel centers inside [X0, X1) x (Y0, Y1]: GL's top-left fill rule,
+     * seen through the y-flipped projection, so a center exactly on the top
+     * edge belongs to the quad above.
+     */
+    int px0 = (int)ceilf(quad->X0 - 0.5f), px1 = (int)ceilf(quad->X1 - 0.5f);
+    int py0 = (int)floorf(quad->Y0 + 0.5f), py1 = (int)floorf(quad->Y1 + 0.5f);
+
+    if (px0 < 0)
+        px0 = 0;
+    if (px1 > target->Width)
+        px1 = target->Width;
+    if (py0 < rowStart)
+        py0 = rowStart;
+    if (py1 > rowEnd)
+        py1 = rowEnd;
+    if (px0 >= px1 || py0 >= py1)
+        return;
+
+    /* Screen pixels -> atlas texels */
+    float texW = (quad->U1 - quad->U0) * atlas->Width;
+    float texH = (quad->V1 - quad->V0) * atlas->Height;
+    float sx = texW / (quad->X1 - quad->X0);
+    float sy = texH / (quad->Y1 - quad->Y0);
+    float tx0 = quad->U0 * atlas->Width;
+    float ty0 = quad->V0 * atlas->Height;
+
+    /* Unscaled glyph on the pixel grid: texel centers hit exactly, no filtering needed */
+    int direct = fabsf(sx - 1.0f) < 1e-4f && fabsf(sy - 1.0f) < 1e-4f &&
+                 quad->X0 == floorf(quad->X0) && quad->Y0 == floorf(quad->Y0);
+
+    int count = px1 - px0;
+    for (int y = py0; y < py1; y++)
+    {
+        unsigned char *dst = target->Pixels + (size_t)y * target->Stride + 4 * px0;
+        const unsigned char *cov;
+
+        if (direct)
+        {
+            int ax = (int)(tx0 + 0.5f) + (px0 - (int)quad->X0);
+            int ay = (int)(ty0 + 0.5f) + (y - (int)quad->Y0);
+            cov = atlas->Pixels + (size_t)ay * atlas->Width + ax;
+        }
+        else
+        {
+            float ty = ty0 + (y + 0.5f - quad->Y0) * sy;
+            for (int x = px0; x < px1; x++)
+                coverage[x - px0] = sampleAtlas(atlas, tx0 + (x + 0.5f - quad->X0) * sx, ty);
+            cov = coverage;
+        }
+
+        blendSpan(dst, cov, count, quad->R, quad->G, quad->B);
+    }
+}
+
+typedef struct
+{
+    SoftTarget *Target;
+    const GlyphAtlas *Atlas;
+    const DrawList *List;
+    int FirstBand;
+    int BandStep;
+} BandJob;
+
+static void *drawBands(void *arg)
+{
+    BandJob *job = (BandJob *)arg;
+    SoftTarget *target = job->Target;
+    unsigned char *coverage = (unsigned char *)malloc(target->Width);
+    if (!coverage)
+        return NULL;
+
+    int numBands = (target->Height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    for (int band = job->FirstBand; band < numBands; band += job->BandStep)
+    {
+        int rowStart = band * BAND_HEIGHT;
+        int rowEnd = rowStart + BAND_HEIGHT < target->Height ? rowStart + BAND_HEIGHT : target->Height;
+
+        /* Quads are visited in list order so overlapping glyphs blend like GL */
+        for (int i = 0; i + 6 <= job->List->Count; i += 6)
+        {
+            const TextVertex *v = job->List->Vertices + i;
+            if (v[2].Y <= rowStart || v[0].Y >= rowEnd)
+                continue;
+
+            SoftQuad quad;
+            quadFromVertices(v, &quad);
+            drawQuad(target, job->Atlas, &quad, rowStart, rowEnd, coverage);
+        }
+    }
+
+    free(coverage);
+    return NULL;
+}
+
+void softRenderDrawList(SoftTarget *target, const GlyphAtlas *atlas, const DrawList *list, int numThreads)
+{
+    int numBands = (target->Height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    if (numThreads > numBands)
+        numThreads = numBands;
+    if (numThreads > MAX_THREADS)
+        numThreads = MAX_THREADS;
+
+    if (numThreads <= 1)
+    {
+        BandJob job = {target, atlas, list, 0, 1};
+        drawBands(&job);
+        return;
+    }
+
+    /* Bands are interleaved so text concentrated in one area is still spread out */
+    pthread_t threads[MAX_THREADS];
+    BandJob jobs[MAX_THREADS];
+    int started = 0;
+
+    for (int t = 0; t < numThreads; t++)
+    {
+        BandJob job = {target, atlas, list, t, numThreads};
+        jobs[t] = job;
+    }
+    for (int t = 1; t < numThreads; t++)
+    {
+        if (pthread_create(&threads[t], NULL, drawBands, &jobs[t]) != 0)
+            break;
+        started = t;
+    }
+
+    /* Bands of threads that failed to start are drawn here */
+    for (int t = started + 1; t < numThreads; t++)
+        drawBands(&jobs[t]);
+    drawBands(&jobs[0]);
+
+    for (int t = 1; t <= started; t++)
+        pthread_join(threads[t], NULL);
+}
@@ -0,0 +1,47 @@
+#ifndef SOFT_RENDERER_H
+#define SOFT_RENDERER_H
+
+#include "glyph_atlas.h"
+#include "text_layout.h"
+
+/*
+ * CPU text backend: composites the glyph quads of a DrawList into an RGBA8
+ * image, no OpenGL required.
+ *
+ * The result matches what the GL path produces with fragmentShaderSource
+ * (color = vec4(textColor, 1.0) * vec4(1, 1, 1, coverage)) and
+ * glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), including the alpha
+ * channel, up to one unit of rounding (softrender_test.c checks this against
+ * Mesa llvmpipe).  Coverage is sampled from the atlas with bilinear
+ * filtering like GL_LINEAR, with 8-bit subtexel weights; quads that map 1:1
+ * onto atlas texels read the atlas rows directly.
+ *
+ * The blend loop uses AVX2 when compiled with it, otherwise SSE2 on x86, and
+ * a scalar loop elsewhere.  Large images are split into bands of rows that
+ * worker threads composite independently.
+ */
+
+typedef struct
+{
+    unsigned char *Pixels; /* RGBA8, top row first */
+    int Width;
+    int Height;
+    int Stride; /* Bytes per row */
+} SoftTarget;
+
+int softTargetCreate(SoftTarget *target, int width, int height);
+void softTargetDestroy(SoftTarget *target);
+
+/* Colors are 0.0-1.0 like glClearColor */
+void softTargetClear(SoftTarget *target, float r, float g, float b, float a);
+
+/* Write the RGB channels as binary PPM, returns 0 on failure */
+int softTargetWritePPM(const SoftTarget *target, const char *path);
+
+/* Composite a draw list, numThreads <= 1 runs on the calling thread */
+void softRenderDrawList(SoftTarget *target, const GlyphAtlas *atlas, const DrawList *list, int numThreads);
+
+/* Name of the blend implementation compiled in ("avx2", "sse2" or "scalar") */
+const char *softRenderBackendName(void);
+
+#endif /* SOFT_RENDERER_H */
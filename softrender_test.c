@@ -0,0 +1,449 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "soft_renderer.h"
+#include "text_layout.h"
+
+#if defined(SOFT_RENDER_TEST_GL)
+#define GL_GLEXT_PROTOTYPES
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/glcorearb.h>
+#endif
+
+/*
+ * 软件渲染后端的测试
+ *
+ *     SoftRenderTest image.rgba [reference.rgba]
+ *         Composites the test scene with 1 and several threads, fails if the
+ *         images differ, writes the image and compares it byte for byte with
+ *         reference (the scalar build's image).  Built once per blend
+ *         implementation.
+ *
+ *     SoftRenderGLTest
+ *         Renders the same scene with OpenGL into an offscreen framebuffer
+ *         (EGL, Mesa llvmpipe) and checks that every channel of the software
+ *         image is within one unit of it.
+ *
+ * Exit code 77 means skipped (no font, no AVX2 CPU, no EGL or no llvmpipe).
+ */
+
+#define WIDTH 800
+#define HEIGHT 600
+#define ATLAS_SIZE 512
+#define SKIP 77
+
+GlyphAtlas atlas;
+DrawList drawList;
+
+static int loadAtlas(void)
+{
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        return 0;
+    }
+
+    /* Keep the index next to the test instead of in the user's cache */
+    FontRegistry fonts;
+    fontRegistryLoad(&fonts, "softrender_test.cache", NULL, 0);
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        fontRegistryDestroy(&fonts);
+        FT_Done_FreeType(ft);
+        return 0;
+    }
+    printf("Font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+
+    FT_Set_Pixel_Sizes(face, 0, 48);
+    int ok = glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE);
+    for (unsigned int c = 32; ok && c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+    return ok;
+}
+
+/* The HelloWorldGLEW scene plus lines that take the unscaled and the overlapping paths */
+static void buildScene(DrawList *list)
+{
+    const char *text = "Hello World!";
+    float scale = 1.5f;
+    float x = (WIDTH - measureText(&atlas, text, scale)) / 2.0f;
+    float y = HEIGHT / 2.0f;
+
+    drawListClear(list);
+    layoutText(list, &atlas, text, x, y - 100, scale, 0, 0, 0);
+
+    /* layoutText() seeds the rainbow from time(), recolor so every run gives the same bytes */
+    int rainbowStart = list->Count;
+    layoutText(list, &atlas, text, x, y, scale, -1, -1, -1);
+    srand(1);
+    for (int i = rainbowStart; i < list->Count; i += 6)
+    {
+        float r, g, b;
+        rainbowColor(&r, &g, &b);
+        for (int j = 0; j < 6; j++)
+        {
+            list->Vertices[i + j].R = r;
+            list->Vertices[i + j].G = g;
+            list->Vertices[i + j].B = b;
+        }
+    }
+
+    layoutText(list, &atlas, text, x, y + 100, scale, 255, 215, 0);
+
+    const char *line = "The quick brown fox jumps over the lazy dog 0123456789";
+    layoutText(list, &atlas, line, 10.0f, 60.0f, 1.0f, 255, 255, 255);
+    layoutText(list, &atlas, line, 14.3f, 72.6f, 0.75f, 40, 90, 200);
+}
+
+static void renderSoft(SoftTarget *target, int numThreads)
+{
+    softTargetClear(target, 0.2f, 0.3f, 0.3f, 1.0f);
+    softRenderDrawList(target, &atlas, &drawList, numThreads);
+}
+
+#if !defined(SOFT_RENDER_TEST_GL)
+
+static int writeImage(const SoftTarget *target, const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return 0;
+    size_t size = (size_t)target->Stride * target->Height;
+    int ok = fwrite(target->Pixels, 1, size, file) == size;
+    return fclose(file) == 0 && ok;
+}
+
+/* 0 when equal, otherwise prints the first differing pixel */
+static int compareImage(const SoftTarget *target, const char *path)
+{
+    size_t size = (size_t)target->Stride * target->Height;
+    unsigned char *reference = (unsigned char *)malloc(size);
+    FILE *file = fopen(path, "rb");
+    if (!reference || !file || fread(reference, 1, size, file) != size)
+    {
+        fprintf(stderr, "ERROR::TEST: Cannot read reference image %s\n", path);
+        if (file)
+            fclose(file);
+        free(reference);
+        return 1;
+    }
+    fclose(file);
+
+    int status = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (target->Pixels[i] != reference[i])
+        {
+            size_t pixel = i / 4;
+            fprintf(stderr, "FAIL: %s differs from %s at (%zu, %zu) channel %zu: %d vs %d\n",
+                    softRenderBackendName(), path, pixel % target->Width, pixel / target->Width,
+                    i % 4, target->Pixels[i], reference[i]);
+            status = 1;
+            break;
+        }
+    }
+
+    free(reference);
+    return status;
+}
+
+static int testBackend(const char *imagePath, const char *referencePath)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (strcmp(softRenderBackendName(), "avx2") == 0 && !__builtin_cpu_supports("avx2"))
+    {
+        printf("SKIP: CPU without AVX2\n");
+        return SKIP;
+    }
+#endif
+
+    SoftTarget single, threaded;
+    if (!softTargetCreate(&single, WIDTH, HEIGHT) || !softTargetCreate(&threaded, WIDTH, HEIGHT))
+        return 1;
+
+    int status = 0;
+    renderSoft(&single, 1);
+
+    /* Band boundaries must not show: 2 threads, an odd count and more threads than bands */
+    int threadCounts[] = {2, 3, 8, 64};
+    for (int i = 0; i < 4 && status == 0; i++)
+    {
+        renderSoft(&threaded, threadCounts[i]);
+        if (memcmp(single.Pixels, threaded.Pixels, (size_t)single.Stride * HEIGHT) != 0)
+        {
+            fprintf(stderr, "FAIL: %s, %d threads differ from 1 thread\n",
+                    softRenderBackendName(), threadCounts[i]);
+            status = 1;
+        }
+    }
+
+    if (status == 0 && !writeImage(&single, imagePath))
+    {
+        fprintf(stderr, "ERROR::TEST: Failed to write %s\n", imagePath);
+        status = 1;
+    }
+    if (status == 0 && referencePath)
+        status = compareImage(&single, referencePath);
+
+    if (status == 0)
+        printf("OK: %s blending, %d glyphs, 1 vs N threads identical%s\n", softRenderBackendName(),
+               drawList.Count / 6, referencePath ? ", matches the scalar image" : "");
+
+    softTargetDestroy(&single);
+    softTargetDestroy(&threaded);
+    return status;
+}
+
+#endif /* !SOFT_RENDER_TEST_GL */
+
+#if defined(SOFT_RENDER_TEST_GL)
+
+/* Same shaders as text_renderer.c */
+static const char *vertexShaderSource =
+    "#version 330 core\n"
+    "layout (location = 0) in vec4 vertex;\n"
+    "layout (location = 1) in vec3 vertexColor;\n"
+    "out vec2 TexCoords;\n"
+    "out vec3 TextColor;\n"
+    "uniform mat4 projection;\n"
+    "void main() {\n"
+    "    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);\n"
+    "    TexCoords = vertex.zw;\n"
+    "    TextColor = vertexColor;\n"
+    "}\0";
+
+static const char *fragmentShaderSource =
+    "#version 330 core\n"
+    "in vec2 TexCoords;\n"
+    "in vec3 TextColor;\n"
+    "out vec4 color;\n"
+    "uniform sampler2D text;\n"
+    "void main() {\n"
+    "    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);\n"
+    "    color = vec4(TextColor, 1.0) * sampled;\n"
+    "}\0";
+
+/* Headless context: surfaceless Mesa platform, otherwise the default display */
+static int createContext(void)
+{
+    EGLDisplay display = EGL_NO_DISPLAY;
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL))
+        return 0;
+
+    EGLint configAttribs[] = {EGL_SURFACE_TYPE, EGL_DONT_CARE, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) ||
+        numConfigs == 0)
+        return 0;
+
+    EGLint contextAttribs[] = {EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+                               EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                               EGL_NONE};
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    return context != EGL_NO_CONTEXT && eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+}
+
+static GLuint compileShader(GLenum type, const char *source)
+{
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        fprintf(stderr, "ERROR::SHADER::COMPILATION_FAILED\n%s\n", infoLog);
+    }
+    return shader;
+}
+
+/* Draw the scene like TextRenderer does and read it back top row first */
+static void renderGL(SoftTarget *target)
+{
+    GLuint fbo, color;
+    glGenRenderbuffers(1, &color);
+    glBindRenderbuffer(GL_RENDERBUFFER, color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH, HEIGHT);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+    glViewport(0, 0, WIDTH, HEIGHT);
+
+    GLuint program = glCreateProgram();
+    GLuint vs = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLfloat projection[16] = {
+        2.0f / WIDTH, 0.0f, 0.0f, 0.0f,
+        0.0f, -2.0f / HEIGHT, 0.0f, 0.0f,
+        0.0f, 0.0f, -1.0f, 0.0f,
+        -1.0f, 1.0f, 0.0f, 1.0f};
+    glUseProgram(program);
+    glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, projection);
+    glUniform1i(glGetUniformLocation(program, "text"), 0);
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlas.Width, atlas.Height, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.Pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    GLuint vao, vbo;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, drawList.Count * sizeof(TextVertex), drawList.Vertices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)(4 * sizeof(GLfloat)));
+
+    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLES, 0, drawList.Count);
+
+    /* GL rows start at the bottom */
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    for (int y = 0; y < HEIGHT; y++)
+        glReadPixels(0, HEIGHT - 1 - y, WIDTH, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                     target->Pixels + (size_t)y * target->Stride);
+
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    glDeleteTextures(1, &texture);
+    glDeleteProgram(program);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &color);
+}
+
+static int testAgainstGL(void)
+{
+    if (!createContext())
+    {
+        printf("SKIP: no headless OpenGL 3.3 context (EGL)\n");
+        return SKIP;
+    }
+
+    const char *renderer = (const char *)glGetString(GL_RENDERER);
+    printf("GL renderer: %s\n", renderer ? renderer : "?");
+    if (!renderer || !strstr(renderer, "llvmpipe"))
+    {
+        printf("SKIP: the tolerance is only established for llvmpipe\n");
+        return SKIP;
+    }
+
+    SoftTarget soft, gl;
+    if (!softTargetCreate(&soft, WIDTH, HEIGHT) || !softTargetCreate(&gl, WIDTH, HEIGHT))
+        return 1;
+    renderSoft(&soft, 4);
+    renderGL(&gl);
+
+    /* soft_renderer.h promises one unit of rounding per channel */
+    int maxDiff = 0, offPixels = 0, changed = 0;
+    size_t size = (size_t)soft.Stride * HEIGHT;
+    for (size_t i = 0; i < size; i += 4)
+    {
+        int off = 0;
+        for (int c = 0; c < 4; c++)
+        {
+            int diff = abs(soft.Pixels[i + c] - gl.Pixels[i + c]);
+            if (diff > maxDiff)
+                maxDiff = diff;
+            off |= diff > 1;
+        }
+        offPixels += off;
+        changed += memcmp(gl.Pixels + i, gl.Pixels, 4) != 0; /* Top-left corner is background */
+    }
+
+    printf("%d pixels covered by text, max channel difference %d, %d pixels off by more than 1\n",
+           changed, maxDiff, offPixels);
+
+    int status = 0;
+    if (changed == 0)
+    {
+        fprintf(stderr, "FAIL: the GL image is empty\n");
+        status = 1;
+    }
+    else if (offPixels > 0)
+    {
+        softTargetWritePPM(&soft, "softrender_soft.ppm");
+        softTargetWritePPM(&gl, "softrender_gl.ppm");
+        fprintf(stderr, "FAIL: software image differs from GL, see softrender_soft.ppm and softrender_gl.ppm\n");
+        status = 1;
+    }
+
+    softTargetDestroy(&soft);
+    softTargetDestroy(&gl);
+    return status;
+}
+
+#endif /* SOFT_RENDER_TEST_GL */
+
+int main(int argc, char **argv)
+{
+    if (!loadAtlas())
+    {
+        printf("SKIP: no usable font\n");
+        return SKIP;
+    }
+
+    drawListInit(&drawList);
+    buildScene(&drawList);
+
+#if defined(SOFT_RENDER_TEST_GL)
+    (void)argc;
+    (void)argv;
+    int status = testAgainstGL();
+#else
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s image.rgba [reference.rgba]\n", argv[0]);
+        return 1;
+    }
+    int status = testBackend(argv[1], argc > 2 ? argv[2] : NULL);
+#endif
+
+    drawListFree(&drawList);
+    glyphAtlasDestroy(&atlas);
+    return status;
+}
@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "soft_renderer.h"
+#include "text_layout.h"
+
+/*
+ * 软件渲染后端
+ *
+ * 不需要 OpenGL：把 HelloWorldGLEW 的画面直接合成到内存中的 RGBA8 图像并
+ * 写成 softtext.ppm。加上 --bench 参数时，用大图反复合成满屏文字，输出
+ * 每秒处理的百万像素数。
+ *
+ *     SoftText [output.ppm]
+ *     SoftText --bench [width height threads frames]
+ */
+
+/* Image dimensions, same as the GL window */
+const int WIDTH = 800, HEIGHT = 600;
+
+#define ATLAS_SIZE 512
+
+FontRegistry fonts;
+GlyphAtlas atlas;
+SoftTarget target;
+DrawList drawList;
+int numThreads = 1;
+
+/* Function prototypes */
+void initFreeType(void);
+void renderText(const char *text, float x, float y, float scale, float r, float g, float b);
+int benchmark(int width, int height, int frames);
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    numThreads = cpus > 0 ? (int)cpus : 1;
+
+    initFreeType();
+    drawListInit(&drawList);
+
+    int status = 0;
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    {
+        int width = argc > 2 ? atoi(argv[2]) : 3840;
+        int height = argc > 3 ? atoi(argv[3]) : 2160;
+        if (argc > 4)
+            numThreads = atoi(argv[4]);
+        int frames = argc > 5 ? atoi(argv[5]) : 20;
+        status = benchmark(width, height, frames);
+    }
+    else
+    {
+        const char *output = argc > 1 ? argv[1] : "softtext.ppm";
+        if (!softTargetCreate(&target, WIDTH, HEIGHT))
+            return -1;
+
+        /* Clear the screen */
+        softTargetClear(&target, 0.2f, 0.3f, 0.3f, 1.0f);
+
+        /* 渲染居中文本 */
+        const char *text = "Hello World!";
+        float scale = 1.5f;
+        float x = (WIDTH - measureText(&atlas, text, scale)) / 2.0f;
+        float y = HEIGHT / 2.0f;
+
+        renderText(text, x, y - 100, scale, 0, 0, 0);     // 黑色
+        renderText(text, x, y, scale, -1, -1, -1);        // 彩虹模式
+        renderText(text, x, y + 100, scale, 255, 215, 0); // 金色
+
+        if (softTargetWritePPM(&target, output))
+            printf("Wrote %s (%s blending)\n", output, softRenderBackendName());
+        else
+        {
+            fprintf(stderr, "Failed to write %s\n", output);
+            status = -1;
+        }
+        softTargetDestroy(&target);
+    }
+
+    drawListFree(&drawList);
+    glyphAtlasDestroy(&atlas);
+    return status;
+}
+
+/* Same signature as the GL renderText(), composites into the global target */
+void renderText(const char *text, float x, float y, float scale, float r, float g, float b)
+{
+    drawListClear(&drawList);
+    layoutText(&drawList, &atlas, text, x, y, scale, r, g, b);
+    softRenderDrawList(&target, &atlas, &drawList, numThreads);
+}
+
+int benchmark(int width, int height, int frames)
+{
+    if (!softTargetCreate(&target, width, height))
+        return -1;
+
+    /* Fill the image with lines: unscaled (direct atlas rows) and scaled (bilinear) */
+    const char *line = "The quick brown fox jumps over the lazy dog 0123456789";
+    drawListClear(&drawList);
+    int lineHeight = 40;
+    for (int y = lineHeight; y < height; y += lineHeight)
+    {
+        float scale = (y / lineHeight) % 2 ? 1.0f : 0.75f;
+        for (float x = 0.0f; x < width;)
+        {
+            float end = layoutText(&drawList, &atlas, line, x, (float)y, scale, 255, 215, 0);
+            if (end <= x)
+                break;
+            x = end + 20.0f;
+        }
+    }
+
+    int glyphs = drawList.Count / 6;
+    double best = 1e30;
+    for (int i = 0; i < frames; i++)
+    {
+        softTargetClear(&target, 0.2f, 0.3f, 0.3f, 1.0f);
+
+        double start = now();
+        softRenderDrawList(&target, &atlas, &drawList, numThreads);
+        double elapsed = now() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+
+    double megapixels = (double)width * height / 1e6;
+    printf("%dx%d, %d glyphs, %d threads, %s blending\n",
+           width, height, glyphs, numThreads, softRenderBackendName());
+    printf("best frame %.3f ms  %.1f megapixels/s  %.2f Mglyphs/s\n",
+           best * 1000.0, megapixels / best, glyphs / best / 1e6);
+
+    softTargetDestroy(&target);
+    return 0;
+}
+
+void initFreeType(void)
+{
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    /* Index installed fonts (cached on disk) and map the best match */
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(ft);
+        exit(1);
+    }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+
+    /* Set size to load glyphs as */
+    FT_Set_Pixel_Sizes(face, 0, 48);
+
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        exit(1);
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+
+    /* Clean up FreeType resources, the face reads from the registry's mapping */
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+}
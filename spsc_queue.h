@@ -0,0 +1,59 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/*
+ * Bounded lock-free single-producer/single-consumer queue of pointers.
+ *
+ * Exactly one thread may call spscPush() and exactly one (other) thread may
+ * call spscPop().  Head is only written by the consumer and tail only by the
+ * producer; the release/acquire pair on them publishes the slot contents, so
+ * whatever the pointer refers to is visible to the consumer once popped.
+ */
+
+#define SPSC_CAPACITY 8 /* Must be a power of two */
+
+typedef struct
+{
+    void *Slots[SPSC_CAPACITY];
+    _Alignas(64) atomic_size_t Head; /* Next slot to pop */
+    _Alignas(64) atomic_size_t Tail; /* Next slot to push */
+} SpscQueue;
+
+static inline void spscInit(SpscQueue *queue)
+{
+    atomic_init(&queue->Head, 0);
+    atomic_init(&queue->Tail, 0);
+}
+
+/* Producer side, returns 0 if the queue is full */
+static inline int spscPush(SpscQueue *queue, void *item)
+{
+    size_t tail = atomic_load_explicit(&queue->Tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&queue->Head, memory_order_acquire);
+
+    if (tail - head == SPSC_CAPACITY)
+        return 0;
+
+    queue->Slots[tail & (SPSC_CAPACITY - 1)] = item;
+    atomic_store_explicit(&queue->Tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+/* Consumer side, returns NULL if the queue is empty */
+static inline void *spscPop(SpscQueue *queue)
+{
+    size_t head = atomic_load_explicit(&queue->Head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&queue->Tail, memory_order_acquire);
+
+    if (head == tail)
+        return NULL;
+
+    void *item = queue->Slots[head & (SPSC_CAPACITY - 1)];
+    atomic_store_explicit(&queue->Head, head + 1, memory_order_release);
+    return item;
+}
+
+#endif /* SPSC_QUEUE_H */
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "font_registry.h"
+#include "glyph_atlas.h"
+#include "text_renderer.h"
+#include "text_style.h"
+
+/*
+ * 单遍描边与阴影
+ *
+ * 以前给文字加阴影和描边要把同一个字符串画三遍（阴影、描边、填充）。这里每个
+ * 字形只生成一个四边形，片段着色器在同一次采样中算出填充、描边和阴影并自行
+ * 混合，三种样式的三行文字只需要一次 draw call。
+ */
+
+/* Window dimensions */
+const GLuint WIDTH = 800, HEIGHT = 600;
+
+#define ATLAS_SIZE 512
+
+/* Style table, StyledVertex.Style indexes it */
+const TextStyle styles[] = {
+    /* 白字黑边 */
+    {255, 255, 255, 3.0f, 0, 0, 0, 0.0f, 0.0f, 0, 0, 0, 0.0f},
+    /* 金色，带投影 */
+    {255, 215, 0, 0.0f, 0, 0, 0, 4.0f, 4.0f, 0, 0, 0, 0.6f},
+    /* 彩虹，深蓝描边加投影 */
+    {-1, -1, -1, 2.0f, 20, 30, 90, 3.0f, 5.0f, 0, 0, 0, 0.5f}};
+
+FontRegistry fonts;
+GlyphAtlas atlas;
+TextRenderer textRenderer;
+GLuint VAO;
+
+/* Function prototypes */
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
+void initFreeType(void);
+
+int main(void)
+{
+    /* Initialize GLFW */
+    if (!glfwInit())
+    {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return -1;
+    }
+
+    /* Set OpenGL version and profile */
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    /* Create a windowed mode window and its OpenGL context */
+    GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Styled Text", NULL, NULL);
+    if (!window)
+    {
+        fprintf(stderr, "Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    /* Set callback functions */
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+
+    /* Initialize GLEW */
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Failed to initialize GLEW\n");
+        return -1;
+    }
+
+    initFreeType();
+
+    textRendererInit(&textRenderer, &atlas);
+    VAO = textRendererCreateStyledVAO(&textRenderer);
+    textRendererSetViewport(&textRenderer, (float)WIDTH, (float)HEIGHT);
+
+    int numStyles = sizeof(styles) / sizeof(styles[0]);
+    textRendererSetStyles(&textRenderer, styles, numStyles);
+
+    /* Enable blending for text rendering */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    StyledDrawList list;
+    styledDrawListInit(&list);
+
+    /* Main loop */
+    while (!glfwWindowShouldClose(window))
+    {
+        /* Clear the screen */
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        /* 三种样式放进同一个列表，一次提交 */
+        const char *text = "Hello World!";
+        float scale = 1.5f;
+        float x = (WIDTH - measureText(&atlas, text, scale)) / 2.0f;
+        float y = HEIGHT / 2.0f;
+
+        styledDrawListClear(&list);
+        for (int i = 0; i < numStyles; i++)
+            layoutStyledText(&list, &atlas, text, x, y + (i - 1) * 100, scale, &styles[i], i);
+        textRendererSubmitStyled(&textRenderer, VAO, &list);
+
+        /* Swap front and back buffers */
+        glfwSwapBuffers(window);
+
+        /* Poll for and process events */
+        glfwPollEvents();
+    }
+
+    /* Clean up */
+    styledDrawListFree(&list);
+    glDeleteVertexArrays(1, &VAO);
+    textRendererDestroy(&textRenderer);
+    glyphAtlasDestroy(&atlas);
+
+    /* Terminate GLFW */
+    glfwTerminate();
+
+    return 0;
+}
+
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GL_TRUE);
+}
+
+void initFreeType(void)
+{
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Could not init FreeType Library\n");
+        exit(1);
+    }
+
+    fontRegistryLoad(&fonts, NULL, NULL, 0);
+
+    FT_Face face;
+    const char *fontFamilies[] = {"Arial", "FreeSans", "DejaVu Sans", "Helvetica"};
+    int numFamilies = sizeof(fontFamilies) / sizeof(fontFamilies[0]);
+    const FontEntry *font = fontRegistryOpenPreferred(&fonts, ft, fontFamilies, numFamilies, 'A', &face);
+    if (!font)
+    {
+        fprintf(stderr, "ERROR::FREETYPE: Failed to load any font.\n");
+        FT_Done_FreeType(ft);
+        exit(1);
+    }
+    printf("Successfully loaded font: %s (%s %s)\n", font->Path, font->Family, font->Style);
+
+    /* Set size to load glyphs as */
+    FT_Set_Pixel_Sizes(face, 0, 48);
+
+    if (!glyphAtlasCreate(&atlas, ATLAS_SIZE, ATLAS_SIZE))
+        exit(1);
+    for (unsigned int c = 32; c < 127; c++)
+        glyphAtlasAdd(&atlas, face, c);
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    fontRegistryDestroy(&fonts);
+}
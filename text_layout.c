@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "text_layout.h"
+#include "utf8.h"
+
+void drawListInit(DrawList *list)
+{
+    memset(list, 0, sizeof(*list));
+}
+
+void drawListFree(DrawList *list)
+{
+    free(list->Vertices);
+    memset(list, 0, sizeof(*list));
+}
+
+void drawListClear(DrawList *list)
+{
+    list->Count = 0;
+}
+
+int drawListReserve(DrawList *list, int count)
+{
+    if (count <= list->Capacity)
+        return 1;
+
+    int capacity = list->Capacity ? list->Capacity : 6 * 64;
+    while (capacity < count)
+        capacity *= 2;
+
+    TextVertex *vertices = (TextVertex *)realloc(list->Vertices, capacity * sizeof(TextVertex));
+    if (!vertices)
+        return 0;
+
+    list->Vertices = vertices;
+    list->Capacity = capacity;
+    return 1;
+}
+
+float measureText(const GlyphAtlas *atlas, const char *text, float scale)
+{
+    float width = 0.0f;
+    const char *p = text;
+
+    while (*p)
+    {
+        const AtlasGlyph *glyph = glyphAtlasFind(atlas, codepoint_from_utf8(&p));
+        if (glyph)
+            width += (glyph->Advance >> 6) * scale;
+    }
+
+    return width;
+}
+
+/* 生成鲜艳的颜色 - 随机选择一个通道接近最大值，其他通道较低 */
+void rainbowColor(float *r, float *g, float *b)
+{
+    int primary = rand() % 3;
+    float high = 0.8f + (rand() % 20) / 100.0f; // 0.8-1.0
+    float low1 = (rand() % 60) / 100.0f;        // 0.0-0.6
+    float low2 = (rand() % 60) / 100.0f;        // 0.0-0.6
+
+    *r = primary == 0 ? high : low1;
+    *g = primary == 1 ? high : (primary == 0 ? low1 : low2);
+    *b = primary == 2 ? high : low2;
+}
+
+float layoutText(DrawList *list, const GlyphAtlas *atlas, const char *text,
+                 float x, float y, float scale, float r, float g, float b)
+{
+    /* Each code point needs at most 6 vertices, bytes >= code points */
+    if (!drawListReserve(list, list->Count + 6 * (int)strlen(text)))
+        return x;
+
+    int rainbowMode = (r < 0 || g < 0 || b < 0);
+    if (rainbowMode)
+        srand(time(NULL));
+
+    float cr = r / 255.0f, cg = g / 255.0f, cb = b / 255.0f;
+    TextVertex *v = list->Vertices + list->Count;
+    const char *p = text;
+
+    while (*p)
+    {
+        const AtlasGlyph *glyph = glyphAtlasFind(atlas, codepoint_from_utf8(&p));
+
+        /* 如果字符未加载，跳过 */
+        if (!glyph)
+            continue;
+
+        if (glyph->Width > 0 && glyph->Height > 0)
+        {
+            if (rainbowMode)
+                rainbowColor(&cr, &cg, &cb);
+
+            /* 基线对齐, y 轴向下 */
+            float x0 = x + glyph->Left * scale;
+            float y0 = y - glyph->Top * scale;
+            float x1 = x0 + glyph->Width * scale;
+            float y1 = y0 + glyph->Height * scale;
+
+            TextVertex quad[6] = {
+                {x0, y0, glyph->U0, glyph->V0, cr, cg, cb}, // 左上
+                {x0, y1, glyph->U0, glyph->V1, cr, cg, cb}, // 左下
+                {x1, y1, glyph->U1, glyph->V1, cr, cg, cb}, // 右下
+
+                {x0, y0, glyph->U0, glyph->V0, cr, cg, cb}, // 左上
+                {x1, y1, glyph->U1, glyph->V1, cr, cg, cb}, // 右下
+                {x1, y0, glyph->U1, glyph->V0, cr, cg, cb}  // 右上
+            };
+            memcpy(v, quad, sizeof(quad));
+            v += 6;
+        }
+
+        x += (glyph->Advance >> 6) * scale;
+    }
+
+    list->Count = (int)(v - list->Vertices);
+    return x;
+}
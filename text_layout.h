@@ -0,0 +1,47 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include "glyph_atlas.h"
+
+/*
+ * CPU side text layout: turns UTF-8 strings into glyph quads (positions,
+ * atlas coordinates, colors).  Nothing here touches OpenGL, so a draw list
+ * can be built on any thread as long as the atlas is not modified meanwhile.
+ */
+
+/* One vertex of a glyph quad: position, atlas coordinates, color */
+typedef struct
+{
+    float X, Y;
+    float U, V;
+    float R, G, B;
+} TextVertex;
+
+/* Vertices of one or more laid out strings, 6 per visible glyph */
+typedef struct
+{
+    TextVertex *Vertices;
+    int Count;
+    int Capacity;
+} DrawList;
+
+void drawListInit(DrawList *list);
+void drawListFree(DrawList *list);
+void drawListClear(DrawList *list);
+int drawListReserve(DrawList *list, int count);
+
+/* Width of a UTF-8 string in pixels */
+float measureText(const GlyphAtlas *atlas, const char *text, float scale);
+
+/* Random vivid color (0.0-1.0) used by the rainbow mode */
+void rainbowColor(float *r, float *g, float *b);
+
+/*
+ * Append the quads of a UTF-8 string with its baseline at y (y axis down).
+ * Colors are 0-255, any negative component selects the rainbow mode.
+ * Returns the pen position after the last glyph.
+ */
+float layoutText(DrawList *list, const GlyphAtlas *atlas, const char *text,
+                 float x, float y, float scale, float r, float g, float b);
+
+#endif /* TEXT_LAYOUT_H */
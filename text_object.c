@@ -0,0 +1,295 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "text_object.h"
+#include "utf8.h"
+
+#define SLOT_VERTICES 6
+#define SLOT_BYTES (SLOT_VERTICES * sizeof(TextVertex))
+#define MERGE_GAP 4 /* Unchanged slots worth re-sending to save a glBufferSubData call */
+
+int textObjectInit(TextObject *object, const TextRenderer *renderer,
+                   float x, float y, float scale, float r, float g, float b)
+{
+    memset(object, 0, sizeof(*object));
+    object->Renderer = renderer;
+    object->X = x;
+    object->Y = y;
+    object->Scale = scale;
+    object->R = r;
+    object->G = g;
+    object->B = b;
+    drawListInit(&object->Slots);
+
+    object->PenX = (float *)malloc(sizeof(float));
+    if (!object->PenX)
+        return 0;
+    object->PenX[0] = x;
+
+    glGenBuffers(1, &object->VBO);
+    object->VAO = textRendererCreateBufferVAO(object->VBO);
+    return 1;
+}
+
+void textObjectDestroy(TextObject *object)
+{
+    glDeleteVertexArrays(1, &object->VAO);
+    glDeleteBuffers(1, &object->VBO);
+    free(object->Codepoints);
+    free(object->Decoded);
+    free(object->PenX);
+    drawListFree(&object->Slots);
+    memset(object, 0, sizeof(*object));
+}
+
+static int reserveCodepoints(TextObject *object, int count)
+{
+    if (count <= object->Capacity)
+        return 1;
+
+    int capacity = object->Capacity ? object->Capacity : 64;
+    while (capacity < count)
+        capacity *= 2;
+
+    unsigned int *codepoints = (unsigned int *)realloc(object->Codepoints, capacity * sizeof(unsigned int));
+    if (!codepoints)
+        return 0;
+    object->Codepoints = codepoints;
+
+    unsigned int *decoded = (unsigned int *)realloc(object->Decoded, capacity * sizeof(unsigned int));
+    if (!decoded)
+        return 0;
+    object->Decoded = decoded;
+
+    float *penX = (float *)realloc(object->PenX, (capacity + 1) * sizeof(float));
+    if (!penX)
+        return 0;
+    object->PenX = penX;
+
+    object->Capacity = capacity;
+    return drawListReserve(&object->Slots, capacity * SLOT_VERTICES);
+}
+
+/* Grow the VBO to hold Length slots, returns 1 when its old contents are gone */
+static int reserveSlots(TextObject *object)
+{
+    if (object->Length <= object->SlotCapacity)
+        return 0;
+
+    int capacity = object->SlotCapacity ? object->SlotCapacity : 16;
+    while (capacity < object->Length)
+        capacity *= 2;
+
+    glBindBuffer(GL_ARRAY_BUFFER, object->VBO);
+    glBufferData(GL_ARRAY_BUFFER, capacity * SLOT_BYTES, NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    object->SlotCapacity = capacity;
+    return 1;
+}
+
+/* Send slots [first, last) to the VBO */
+static void uploadSlots(TextObject *object, int first, int last)
+{
+    if (last <= first)
+        return;
+
+    GLsizeiptr size = (last - first) * SLOT_BYTES;
+    glBindBuffer(GL_ARRAY_BUFFER, object->VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, first * SLOT_BYTES, size,
+                    object->Slots.Vertices + first * SLOT_VERTICES);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    object->LastUploadBytes += size;
+    object->TotalUploadBytes += size;
+}
+
+static void layoutSlot(TextObject *object, const AtlasGlyph *glyph, int i, float *cr, float *cg, float *cb)
+{
+    TextVertex *v = object->Slots.Vertices + i * SLOT_VERTICES;
+    float x = object->PenX[i];
+    float scale = object->Scale;
+
+    /* Missing and empty glyphs get a degenerate quad so slot i stays code point i */
+    if (!glyph || glyph->Width == 0 || glyph->Height == 0)
+    {
+        for (int k = 0; k < SLOT_VERTICES; k++)
+            v[k] = (TextVertex){x, object->Y, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        object->PenX[i + 1] = glyph ? x + (glyph->Advance >> 6) * scale : x;
+        return;
+    }
+
+    if (object->R < 0 || object->G < 0 || object->B < 0)
+        rainbowColor(cr, cg, cb);
+
+    /* 基线对齐, y 轴向下 */
+    float x0 = x + glyph->Left * scale;
+    float y0 = object->Y - glyph->Top * scale;
+    float x1 = x0 + glyph->Width * scale;
+    float y1 = y0 + glyph->Height * scale;
+
+    TextVertex quad[SLOT_VERTICES] = {
+        {x0, y0, glyph->U0, glyph->V0, *cr, *cg, *cb}, // 左上
+        {x0, y1, glyph->U0, glyph->V1, *cr, *cg, *cb}, // 左下
+        {x1, y1, glyph->U1, glyph->V1, *cr, *cg, *cb}, // 右下
+
+        {x0, y0, glyph->U0, glyph->V0, *cr, *cg, *cb}, // 左上
+        {x1, y1, glyph->U1, glyph->V1, *cr, *cg, *cb}, // 右下
+        {x1, y0, glyph->U1, glyph->V0, *cr, *cg, *cb}  // 右上
+    };
+    memcpy(v, quad, sizeof(quad));
+    object->PenX[i + 1] = x + (glyph->Advance >> 6) * scale;
+}
+
+/*
+ * Lay out slots [first, last) of codepoints, starting at PenX[first].
+ * With a previous string, slots holding the same code point at the same
+ * pen position are left alone; the others are uploaded in runs when upload
+ * is set.  Without one every slot is laid out.
+ */
+static void layoutSlots(TextObject *object, const unsigned int *codepoints, int first, int last,
+                        const unsigned int *previous, int previousLength, int upload)
+{
+    const GlyphAtlas *atlas = object->Renderer->Atlas;
+    float cr = object->R / 255.0f, cg = object->G / 255.0f, cb = object->B / 255.0f;
+    float oldPen = object->PenX[first];
+    int runStart = -1, runEnd = -1;
+
+    for (int i = first; i < last; i++)
+    {
+        /* PenX[i + 1] still holds the old string's value until slot i is laid out */
+        float oldNext = i < previousLength ? object->PenX[i + 1] : 0.0f;
+        int same = previous && i < previousLength && codepoints[i] == previous[i] &&
+                   object->PenX[i] == oldPen;
+        oldPen = oldNext;
+        if (same)
+            continue;
+
+        layoutSlot(object, glyphAtlasFind(atlas, codepoints[i]), i, &cr, &cg, &cb);
+
+        /* Runs closer than MERGE_GAP slots go up in one call */
+        if (runStart >= 0 && i - runEnd >= MERGE_GAP)
+        {
+            if (upload)
+                uploadSlots(object, runStart, runEnd);
+            runStart = -1;
+        }
+        if (runStart < 0)
+            runStart = i;
+        runEnd = i + 1;
+    }
+
+    if (upload && runStart >= 0)
+        uploadSlots(object, runStart, runEnd);
+}
+
+int textObjectSet(TextObject *object, const char *text)
+{
+    object->LastUploadBytes = 0;
+
+    /* Bytes >= code points */
+    if (!reserveCodepoints(object, (int)strlen(text)))
+        return 0;
+
+    int length = 0;
+    const char *p = text;
+    while (*p)
+        object->Decoded[length++] = codepoint_from_utf8(&p);
+
+    /* Common prefix and suffix with the current string */
+    const unsigned int *previous = object->Codepoints;
+    int previousLength = object->Length;
+    int shorter = length < previousLength ? length : previousLength;
+    int prefix = 0;
+    while (prefix < shorter && object->Decoded[prefix] == previous[prefix])
+        prefix++;
+    int suffix = 0;
+    while (suffix < shorter - prefix &&
+           object->Decoded[length - 1 - suffix] == previous[previousLength - 1 - suffix])
+        suffix++;
+
+    /* Pen where the old suffix started, before PenX is overwritten */
+    float oldSuffixPen = object->PenX[previousLength - suffix];
+
+    object->Length = length;
+    object->Slots.Count = length * SLOT_VERTICES;
+    int grown = reserveSlots(object);
+
+    int changedEnd = length - suffix;
+    layoutSlots(object, object->Decoded, prefix, changedEnd, previous, previousLength, !grown);
+
+    /* The suffix keeps its slots unless it moved to other slots or in x */
+    if (length != previousLength || object->PenX[changedEnd] != oldSuffixPen)
+    {
+        layoutSlots(object, object->Decoded, changedEnd, length, NULL, 0, 0);
+        if (!grown)
+            uploadSlots(object, changedEnd, length);
+    }
+    if (grown)
+        uploadSlots(object, 0, length);
+
+    /* The new string becomes the current one */
+    unsigned int *swap = object->Codepoints;
+    object->Codepoints = object->Decoded;
+    object->Decoded = swap;
+    return 1;
+}
+
+int textObjectPrintf(TextObject *object, const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+
+    va_start(args, format);
+    int needed = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (needed < 0)
+        return 0;
+    if (needed < (int)sizeof(buffer))
+        return textObjectSet(object, buffer);
+
+    /* Too long for the stack buffer */
+    char *text = (char *)malloc(needed + 1);
+    if (!text)
+        return 0;
+    va_start(args, format);
+    vsnprintf(text, needed + 1, format, args);
+    va_end(args);
+
+    int result = textObjectSet(object, text);
+    free(text);
+    return result;
+}
+
+/* Lay out and upload every slot again */
+static void refreshAll(TextObject *object)
+{
+    object->LastUploadBytes = 0;
+    object->PenX[0] = object->X;
+    layoutSlots(object, object->Codepoints, 0, object->Length, NULL, 0, 0);
+    uploadSlots(object, 0, object->Length);
+}
+
+void textObjectSetPosition(TextObject *object, float x, float y)
+{
+    object->X = x;
+    object->Y = y;
+    refreshAll(object);
+}
+
+void textObjectSetColor(TextObject *object, float r, float g, float b)
+{
+    object->R = r;
+    object->G = g;
+    object->B = b;
+    refreshAll(object);
+}
+
+float textObjectWidth(const TextObject *object)
+{
+    return object->PenX[object->Length] - object->X;
+}
+
+void textObjectDraw(const TextObject *object)
+{
+    textRendererDrawVertices(object->Renderer, object->VAO, object->Length * SLOT_VERTICES);
+}
@@ -0,0 +1,68 @@
+#ifndef TEXT_OBJECT_H
+#define TEXT_OBJECT_H
+
+#include <GL/glew.h>
+#include "glyph_atlas.h"
+#include "text_layout.h"
+#include "text_renderer.h"
+
+/*
+ * Updatable text: counters, clocks, tickers.
+ *
+ * A TextObject keeps one glyph slot (6 vertices) per code point in its own
+ * vertex buffer.  textObjectSet() compares the new string with the previous
+ * one and lays out and uploads (glBufferSubData) only the runs of slots that
+ * changed, so a HUD counter costs a few hundred bytes per frame however long
+ * its line is.  A changed length or changed advance widths move the rest of
+ * the string, which is then uploaded too; the unchanged prefix never is.
+ *
+ * The vertex array object belongs to the context that was current in
+ * textObjectInit().
+ */
+
+typedef struct
+{
+    const TextRenderer *Renderer;
+    GLuint VBO;
+    GLuint VAO;
+    int SlotCapacity; /* Glyph slots the VBO can hold */
+
+    float X, Y, Scale;
+    float R, G, B; /* 0-255, any negative selects the rainbow mode */
+
+    /* Current string, one entry per code point, and the pen x before each */
+    unsigned int *Codepoints;
+    unsigned int *Decoded; /* Scratch for the next string */
+    float *PenX;           /* Length + 1 entries */
+    int Length;
+    int Capacity;
+
+    /* CPU copy of the slots, 6 vertices per code point */
+    DrawList Slots;
+
+    /* Bytes sent by the last textObjectSet() and since textObjectInit() */
+    long LastUploadBytes;
+    long TotalUploadBytes;
+} TextObject;
+
+int textObjectInit(TextObject *object, const TextRenderer *renderer,
+                   float x, float y, float scale, float r, float g, float b);
+void textObjectDestroy(TextObject *object);
+
+/* Replace the string, uploading only what changed */
+int textObjectSet(TextObject *object, const char *text);
+
+/* Printf-style textObjectSet() */
+int textObjectPrintf(TextObject *object, const char *format, ...);
+
+/* Move or recolor the whole string, this re-uploads every slot */
+void textObjectSetPosition(TextObject *object, float x, float y);
+void textObjectSetColor(TextObject *object, float r, float g, float b);
+
+/* Width of the current string in pixels */
+float textObjectWidth(const TextObject *object);
+
+/* One draw call, nothing is uploaded */
+void textObjectDraw(const TextObject *object);
+
+#endif /* TEXT_OBJECT_H */
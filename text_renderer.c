@@ -0,0 +1,396 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "text_renderer.h"
+
+/* Shader sources */
+static const char *textVertexShaderSource =
+    "#version 330 core\n"
+    "layout (location = 0) in vec4 vertex;\n"
+    "layout (location = 1) in vec3 vertexColor;\n"
+    "out vec2 TexCoords;\n"
+    "out vec3 TextColor;\n"
+    "uniform mat4 projection;\n"
+    "void main() {\n"
+    "    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);\n"
+    "    TexCoords = vertex.zw;\n"
+    "    TextColor = vertexColor;\n"
+    "}\0";
+
+static const char *textFragmentShaderSource =
+    "#version 330 core\n"
+    "in vec2 TexCoords;\n"
+    "in vec3 TextColor;\n"
+    "out vec4 color;\n"
+    "uniform sampler2D text;\n"
+    "void main() {\n"
+    "    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);\n"
+    "    color = vec4(TextColor, 1.0) * sampled;\n"
+    "}\0";
+
+/* Styled variant: shadow and outline quads, then fill quads, in one draw call */
+static const char *styledVertexShaderSource =
+    "#version 330 core\n"
+    "layout (location = 0) in vec4 vertex;\n"
+    "layout (location = 1) in vec3 vertexColor;\n"
+    "layout (location = 2) in vec4 glyphRect;\n"
+    "layout (location = 3) in vec2 styleLayer;\n"
+    "out vec2 TexCoords;\n"
+    "out vec3 FillColor;\n"
+    "flat out vec4 GlyphRect;\n"
+    "flat out int Style;\n"
+    "flat out int Layer;\n"
+    "uniform mat4 projection;\n"
+    "void main() {\n"
+    "    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);\n"
+    "    TexCoords = vertex.zw;\n"
+    "    FillColor = vertexColor;\n"
+    "    GlyphRect = glyphRect;\n"
+    "    Style = int(styleLayer.x + 0.5);\n"
+    "    Layer = int(styleLayer.y + 0.5);\n"
+    "}\0";
+
+static const char *styledFragmentShaderSource =
+    "#version 330 core\n"
+    "#define MAX_STYLES 16\n"
+    "in vec2 TexCoords;\n"
+    "in vec3 FillColor;\n"
+    "flat in vec4 GlyphRect;\n"
+    "flat in int Style;\n"
+    "flat in int Layer;\n"
+    "out vec4 color;\n"
+    "uniform sampler2D text;\n"
+    "uniform vec4 outline[MAX_STYLES];\n" /* rgb, width in pixels */
+    "uniform vec4 shadow[MAX_STYLES];\n"  /* rgba */
+    "uniform vec2 shadowOffset[MAX_STYLES];\n"
+    "float coverage(vec2 uv, vec4 rect) {\n"
+    "    if (any(lessThan(uv, rect.xy)) || any(greaterThan(uv, rect.zw))) return 0.0;\n"
+    "    return textureLod(text, uv, 0.0).r;\n"
+    "}\n"
+    "vec4 over(vec4 src, vec4 dst) {\n"
+    "    float a = src.a + dst.a * (1.0 - src.a);\n"
+    "    vec3 rgb = src.rgb * src.a + dst.rgb * dst.a * (1.0 - src.a);\n"
+    "    return vec4(a > 0.0 ? rgb / a : vec3(0.0), a);\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 texel = 1.0 / vec2(textureSize(text, 0));\n"
+    /* Half a texel of slack reaches the zero padding around the bitmap, no further */
+    "    vec4 rect = GlyphRect + vec4(-0.5, -0.5, 0.5, 0.5) * texel.xyxy;\n"
+    /* Quads are axis aligned, so this is texture units per screen pixel */
+    "    vec2 perPixel = abs(vec2(dFdx(TexCoords.x), dFdy(TexCoords.y)));\n"
+    "    float fill = coverage(TexCoords, rect);\n"
+    "    if (Layer == 1) {\n"
+    "        color = vec4(FillColor, fill);\n"
+    "        return;\n"
+    "    }\n"
+    "    float width = outline[Style].a;\n"
+    "    float edge = 0.0;\n"
+    "    if (width > 0.0) {\n"
+    "        edge = fill;\n"
+    "        for (int i = 0; i < 12; i++) {\n"
+    "            float angle = 6.2831853 * float(i) / 12.0;\n"
+    "            vec2 dir = vec2(cos(angle), sin(angle)) * perPixel;\n"
+    "            edge = max(edge, coverage(TexCoords + dir * width, rect));\n"
+    "            edge = max(edge, coverage(TexCoords + dir * width * 0.5, rect));\n"
+    "        }\n"
+    "    }\n"
+    "    float shade = 0.0;\n"
+    "    if (shadow[Style].a > 0.0)\n"
+    "        shade = coverage(TexCoords - shadowOffset[Style] * perPixel, rect) * shadow[Style].a;\n"
+    "    vec4 result = vec4(shadow[Style].rgb, shade);\n"
+    "    color = over(vec4(outline[Style].rgb, edge), result);\n"
+    "}\0";
+
+static GLuint compileProgram(const char *vertexSource, const char *fragmentSource)
+{
+    GLint success;
+    GLchar infoLog[512];
+
+    /* Compile vertex shader */
+    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &vertexSource, NULL);
+    glCompileShader(vertexShader);
+    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
+        fprintf(stderr, "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n%s\n", infoLog);
+    }
+
+    /* Compile fragment shader */
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
+    glCompileShader(fragmentShader);
+    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
+        fprintf(stderr, "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n%s\n", infoLog);
+    }
+
+    /* Link shaders */
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        fprintf(stderr, "ERROR::SHADER::PROGRAM::LINKING_FAILED\n%s\n", infoLog);
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    return program;
+}
+
+int textRendererInit(TextRenderer *renderer, GlyphAtlas *atlas)
+{
+    memset(renderer, 0, sizeof(*renderer));
+    renderer->Atlas = atlas;
+
+    renderer->ShaderProgram = compileProgram(textVertexShaderSource, textFragmentShaderSource);
+    renderer->StyledProgram = compileProgram(styledVertexShaderSource, styledFragmentShaderSource);
+
+    /* Atlas texture, filled by textRendererSyncAtlas() */
+    glGenTextures(1, &renderer->AtlasTexture);
+    glBindTexture(GL_TEXTURE_2D, renderer->AtlasTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlas->Width, atlas->Height, 0,
+                 GL_RED, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    /* The whole atlas is uploaded the first time */
+    atlas->DirtyX0 = 0;
+    atlas->DirtyY0 = 0;
+    atlas->DirtyX1 = atlas->Width;
+    atlas->DirtyY1 = atlas->Height;
+    textRendererSyncAtlas(renderer);
+
+    glGenBuffers(1, &renderer->VBO);
+
+    glUseProgram(renderer->ShaderProgram);
+    glUniform1i(glGetUniformLocation(renderer->ShaderProgram, "text"), 0);
+    glUseProgram(renderer->StyledProgram);
+    glUniform1i(glGetUniformLocation(renderer->StyledProgram, "text"), 0);
+    glUseProgram(0);
+
+    return renderer->ShaderProgram != 0 && renderer->StyledProgram != 0;
+}
+
+void textRendererDestroy(TextRenderer *renderer)
+{
+    glDeleteBuffers(1, &renderer->VBO);
+    glDeleteTextures(1, &renderer->AtlasTexture);
+    glDeleteProgram(renderer->ShaderProgram);
+    glDeleteProgram(renderer->StyledProgram);
+    drawListFree(&renderer->Staging);
+    memset(renderer, 0, sizeof(*renderer));
+}
+
+GLuint textRendererCreateVAO(const TextRenderer *renderer)
+{
+    return textRendererCreateBufferVAO(renderer->VBO);
+}
+
+GLuint textRendererCreateBufferVAO(GLuint vbo)
+{
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex),
+                          (void *)(4 * sizeof(GLfloat)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    return vao;
+}
+
+GLuint textRendererCreateStyledVAO(const TextRenderer *renderer)
+{
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, renderer->VBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(StyledVertex), (void *)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(StyledVertex),
+                          (void *)(4 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(StyledVertex),
+                          (void *)(7 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(StyledVertex),
+                          (void *)(11 * sizeof(GLfloat)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    return vao;
+}
+
+void textRendererSyncAtlas(TextRenderer *renderer)
+{
+    GlyphAtlas *atlas = renderer->Atlas;
+    if (!glyphAtlasIsDirty(atlas))
+        return;
+
+    /* Upload only the dirty rows/columns of the CPU image */
+    glBindTexture(GL_TEXTURE_2D, renderer->AtlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, atlas->Width);
+    glTexSubImage2D(GL_TEXTURE_2D, 0,
+                    atlas->DirtyX0, atlas->DirtyY0,
+                    atlas->DirtyX1 - atlas->DirtyX0,
+                    atlas->DirtyY1 - atlas->DirtyY0,
+                    GL_RED, GL_UNSIGNED_BYTE,
+                    atlas->Pixels + (size_t)atlas->DirtyY0 * atlas->Width + atlas->DirtyX0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glyphAtlasClearDirty(atlas);
+}
+
+void textRendererSetViewport(const TextRenderer *renderer, float width, float height)
+{
+    textRendererSetView(renderer, 0.0f, 0.0f, width, height);
+}
+
+void textRendererSetView(const TextRenderer *renderer, float x, float y, float width, float height)
+{
+    GLfloat projection[16] = {
+        2.0f / width, 0.0f, 0.0f, 0.0f,
+        0.0f, -2.0f / height, 0.0f, 0.0f,
+        0.0f, 0.0f, -1.0f, 0.0f,
+        -1.0f - 2.0f * x / width, 1.0f + 2.0f * y / height, 0.0f, 1.0f};
+
+    GLuint programs[2] = {renderer->ShaderProgram, renderer->StyledProgram};
+    for (int i = 0; i < 2; i++)
+    {
+        glUseProgram(programs[i]);
+        GLint projLoc = glGetUniformLocation(programs[i], "projection");
+        glUniformMatrix4fv(projLoc, 1, GL_FALSE, projection);
+    }
+}
+
+float textRendererMeasure(const TextRenderer *renderer, const char *text, float scale)
+{
+    return measureText(renderer->Atlas, text, scale);
+}
+
+/* Copy vertices into the shared VBO, growing or orphaning its store */
+static void uploadVertices(TextRenderer *renderer, const void *data, GLsizeiptr size)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, renderer->VBO);
+    if (size > renderer->BufferSize)
+    {
+        glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+        renderer->BufferSize = size;
+    }
+    else
+    {
+        /* Orphan the old store so we do not wait for the previous draw */
+        glBufferData(GL_ARRAY_BUFFER, renderer->BufferSize, NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void textRendererSubmit(TextRenderer *renderer, GLuint vao, const DrawList *list)
+{
+    if (list->Count == 0)
+        return;
+
+    uploadVertices(renderer, list->Vertices, list->Count * sizeof(TextVertex));
+    textRendererDrawVertices(renderer, vao, list->Count);
+}
+
+void textRendererDrawVertices(const TextRenderer *renderer, GLuint vao, int count)
+{
+    GLint first = 0;
+    GLsizei counts = count;
+    textRendererDrawRanges(renderer, vao, &first, &counts, 1);
+}
+
+void textRendererDrawRanges(const TextRenderer *renderer, GLuint vao,
+                            const GLint *first, const GLsizei *count, int ranges)
+{
+    if (ranges == 0)
+        return;
+
+    glUseProgram(renderer->ShaderProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, renderer->AtlasTexture);
+    glBindVertexArray(vao);
+
+    if (ranges == 1)
+        glDrawArrays(GL_TRIANGLES, first[0], count[0]);
+    else
+        glMultiDrawArrays(GL_TRIANGLES, first, count, ranges);
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void textRendererSetStyles(const TextRenderer *renderer, const TextStyle *styles, int count)
+{
+    GLfloat outline[MAX_TEXT_STYLES][4];
+    GLfloat shadow[MAX_TEXT_STYLES][4];
+    GLfloat shadowOffset[MAX_TEXT_STYLES][2];
+
+    if (count > MAX_TEXT_STYLES)
+        count = MAX_TEXT_STYLES;
+
+    for (int i = 0; i < count; i++)
+    {
+        const TextStyle *style = &styles[i];
+        outline[i][0] = style->OutlineR / 255.0f;
+        outline[i][1] = style->OutlineG / 255.0f;
+        outline[i][2] = style->OutlineB / 255.0f;
+        outline[i][3] = style->OutlineWidth;
+        shadow[i][0] = style->ShadowR / 255.0f;
+        shadow[i][1] = style->ShadowG / 255.0f;
+        shadow[i][2] = style->ShadowB / 255.0f;
+        shadow[i][3] = style->ShadowA;
+        shadowOffset[i][0] = style->ShadowX;
+        shadowOffset[i][1] = style->ShadowY;
+    }
+
+    GLuint program = renderer->StyledProgram;
+    glUseProgram(program);
+    glUniform4fv(glGetUniformLocation(program, "outline"), count, &outline[0][0]);
+    glUniform4fv(glGetUniformLocation(program, "shadow"), count, &shadow[0][0]);
+    glUniform2fv(glGetUniformLocation(program, "shadowOffset"), count, &shadowOffset[0][0]);
+}
+
+void textRendererSubmitStyled(TextRenderer *renderer, GLuint vao, const StyledDrawList *list)
+{
+    if (list->Count == 0)
+        return;
+
+    glUseProgram(renderer->StyledProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, renderer->AtlasTexture);
+    glBindVertexArray(vao);
+    uploadVertices(renderer, list->Vertices, list->Count * sizeof(StyledVertex));
+
+    glDrawArrays(GL_TRIANGLES, 0, list->Count);
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void textRendererDraw(TextRenderer *renderer, GLuint vao, const char *text,
+                      float x, float y, float scale, float r, float g, float b)
+{
+    drawListClear(&renderer->Staging);
+    layoutText(&renderer->Staging, renderer->Atlas, text, x, y, scale, r, g, b);
+    textRendererSubmit(renderer, vao, &renderer->Staging);
+}
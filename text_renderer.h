@@ -0,0 +1,82 @@
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <GL/glew.h>
+#include "glyph_atlas.h"
+#include "text_layout.h"
+#include "text_style.h"
+
+/*
+ * Batched OpenGL text renderer on top of a GlyphAtlas.
+ *
+ * The program, vertex buffer and atlas texture are ordinary GL objects, so
+ * they can be created once and used from every context of a share group
+ * (glfwCreateWindow with a shared window).  Vertex array objects are NOT
+ * shared between contexts, every context needs its own one from
+ * textRendererCreateVAO().
+ */
+
+typedef struct
+{
+    GLuint ShaderProgram;
+    GLuint StyledProgram; /* Single-pass fill/outline/shadow variant */
+    GLuint VBO;
+    GLuint AtlasTexture;
+    GlyphAtlas *Atlas;
+
+    /* CPU staging for textRendererDraw() */
+    DrawList Staging;
+
+    /* Size of the VBO data store in bytes */
+    GLsizeiptr BufferSize;
+} TextRenderer;
+
+/* Create the shared objects in the current context */
+int textRendererInit(TextRenderer *renderer, GlyphAtlas *atlas);
+void textRendererDestroy(TextRenderer *renderer);
+
+/* Create a VAO for the current context, bound to the shared VBO */
+GLuint textRendererCreateVAO(const TextRenderer *renderer);
+
+/* VAO reading TextVertex data from a buffer of the caller's (see text_object.h) */
+GLuint textRendererCreateBufferVAO(GLuint vbo);
+
+/* Same for StyledDrawList vertices, also per context */
+GLuint textRendererCreateStyledVAO(const TextRenderer *renderer);
+
+/* Upload glyphs added to the atlas since the last call */
+void textRendererSyncAtlas(TextRenderer *renderer);
+
+/* Pixel projection with origin at the top-left corner */
+void textRendererSetViewport(const TextRenderer *renderer, float width, float height);
+
+/* Same, but (x, y) instead of (0, 0) ends up in the top-left corner */
+void textRendererSetView(const TextRenderer *renderer, float x, float y, float width, float height);
+
+/* Width of a UTF-8 string in pixels */
+float textRendererMeasure(const TextRenderer *renderer, const char *text, float scale);
+
+/* Upload a draw list built by layoutText() and draw it in one call */
+void textRendererSubmit(TextRenderer *renderer, GLuint vao, const DrawList *list);
+
+/* Draw the first count vertices of a VAO's buffer with the text program */
+void textRendererDrawVertices(const TextRenderer *renderer, GLuint vao, int count);
+
+/* Draw several vertex ranges of a VAO's buffer in one glMultiDrawArrays() */
+void textRendererDrawRanges(const TextRenderer *renderer, GLuint vao,
+                            const GLint *first, const GLsizei *count, int ranges);
+
+/* Load the style table that StyledVertex.Style indexes (at most MAX_TEXT_STYLES) */
+void textRendererSetStyles(const TextRenderer *renderer, const TextStyle *styles, int count);
+
+/* Draw a styled draw list: shadow, outline and fill of every glyph in one draw call */
+void textRendererSubmitStyled(TextRenderer *renderer, GLuint vao, const StyledDrawList *list);
+
+/*
+ * Lay out and draw a UTF-8 string with its baseline at y in one draw call.
+ * Colors are 0-255, any negative component selects the rainbow mode.
+ */
+void textRendererDraw(TextRenderer *renderer, GLuint vao, const char *text,
+                      float x, float y, float scale, float r, float g, float b);
+
+#endif /* TEXT_RENDERER_H */
@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "text_layout.h"
+#include "text_style.h"
+#include "utf8.h"
+
+void styledDrawListInit(StyledDrawList *list)
+{
+    memset(list, 0, sizeof(*list));
+}
+
+void styledDrawListFree(StyledDrawList *list)
+{
+    free(list->Vertices);
+    memset(list, 0, sizeof(*list));
+}
+
+void styledDrawListClear(StyledDrawList *list)
+{
+    list->Count = 0;
+}
+
+static int reserveStyled(StyledDrawList *list, int count)
+{
+    if (count <= list->Capacity)
+        return 1;
+
+    int capacity = list->Capacity ? list->Capacity : 6 * 64;
+    while (capacity < count)
+        capacity *= 2;
+
+    StyledVertex *vertices = (StyledVertex *)realloc(list->Vertices, capacity * sizeof(StyledVertex));
+    if (!vertices)
+        return 0;
+
+    list->Vertices = vertices;
+    list->Capacity = capacity;
+    return 1;
+}
+
+/* Append one quad per glyph, grown by the given padding, returns the pen position */
+static float layoutLayer(StyledDrawList *list, const GlyphAtlas *atlas, const char *text,
+                         float x, float y, float scale, const TextStyle *style, float s, float layer,
+                         float padLeft, float padRight, float padTop, float padBottom)
+{
+    int rainbowMode = layer > 0.0f && (style->FillR < 0 || style->FillG < 0 || style->FillB < 0);
+    float cr = style->FillR / 255.0f, cg = style->FillG / 255.0f, cb = style->FillB / 255.0f;
+    StyledVertex *v = list->Vertices + list->Count;
+    const char *p = text;
+
+    while (*p)
+    {
+        const AtlasGlyph *glyph = glyphAtlasFind(atlas, codepoint_from_utf8(&p));
+        if (!glyph)
+            continue;
+
+        if (glyph->Width > 0 && glyph->Height > 0)
+        {
+            if (rainbowMode)
+                rainbowColor(&cr, &cg, &cb);
+
+            /* Glyph rectangle on screen, y axis down */
+            float gx0 = x + glyph->Left * scale;
+            float gy0 = y - glyph->Top * scale;
+            float gx1 = gx0 + glyph->Width * scale;
+            float gy1 = gy0 + glyph->Height * scale;
+
+            /* Padded quad, texture coordinates extrapolated past the bitmap */
+            float du = (glyph->U1 - glyph->U0) / (gx1 - gx0);
+            float dv = (glyph->V1 - glyph->V0) / (gy1 - gy0);
+            float x0 = gx0 - padLeft, x1 = gx1 + padRight;
+            float y0 = gy0 - padTop, y1 = gy1 + padBottom;
+            float u0 = glyph->U0 - padLeft * du, u1 = glyph->U1 + padRight * du;
+            float v0 = glyph->V0 - padTop * dv, v1 = glyph->V1 + padBottom * dv;
+
+            StyledVertex quad[6] = {
+                {x0, y0, u0, v0, cr, cg, cb, glyph->U0, glyph->V0, glyph->U1, glyph->V1, s, layer}, // 左上
+                {x0, y1, u0, v1, cr, cg, cb, glyph->U0, glyph->V0, glyph->U1, glyph->V1, s, layer}, // 左下
+                {x1, y1, u1, v1, cr, cg, cb, glyph->U0, glyph->V0, glyph->U1, glyph->V1, s, layer}, // 右下
+
+                {x0, y0, u0, v0, cr, cg, cb, glyph->U0, glyph->V0, glyph->U1, glyph->V1, s, layer}, // 左上
+                {x1, y1, u1, v1, cr, cg, cb, glyph->U0, glyph->V0, glyph->U1, glyph->V1, s, layer}, // 右下
+                {x1, y0, u1, v0, cr, cg, cb, glyph->U0, glyph->V0, glyph->U1, glyph->V1, s, layer}  // 右上
+            };
+            memcpy(v, quad, sizeof(quad));
+            v += 6;
+        }
+
+        x += (glyph->Advance >> 6) * scale;
+    }
+
+    list->Count = (int)(v - list->Vertices);
+    return x;
+}
+
+float layoutStyledText(StyledDrawList *list, const GlyphAtlas *atlas, const char *text,
+                       float x, float y, float scale,
+                       const TextStyle *style, int styleIndex)
+{
+    /* Up to two quads per glyph: background and fill */
+    if (!reserveStyled(list, list->Count + 2 * 6 * (int)strlen(text)))
+        return x;
+
+    if (style->FillR < 0 || style->FillG < 0 || style->FillB < 0)
+        srand(time(NULL));
+
+    /* Grow background quads so the outline and the shadow fit inside them */
+    float outline = style->OutlineWidth > 0.0f ? style->OutlineWidth : 0.0f;
+    float shadowX = style->ShadowA > 0.0f ? style->ShadowX : 0.0f;
+    float shadowY = style->ShadowA > 0.0f ? style->ShadowY : 0.0f;
+    float s = (float)styleIndex;
+
+    /* Shadows and outlines of the whole string first, fills on top of all of them */
+    if (outline > 0.0f || style->ShadowA > 0.0f)
+    {
+        layoutLayer(list, atlas, text, x, y, scale, style, s, 0.0f,
+                    outline + (shadowX < 0.0f ? -shadowX : 0.0f),
+                    outline + (shadowX > 0.0f ? shadowX : 0.0f),
+                    outline + (shadowY < 0.0f ? -shadowY : 0.0f),
+                    outline + (shadowY > 0.0f ? shadowY : 0.0f));
+    }
+    return layoutLayer(list, atlas, text, x, y, scale, style, s, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+}
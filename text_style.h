@@ -0,0 +1,62 @@
+#ifndef TEXT_STYLE_H
+#define TEXT_STYLE_H
+
+#include "glyph_atlas.h"
+
+/*
+ * Styled text: fill, outline and drop shadow drawn in a single pass.
+ *
+ * Instead of one draw call per layer (shadow, then outline, then fill), a
+ * string is appended to one list twice: first a background quad per glyph,
+ * grown by the outline width and the shadow offset, in which the fragment
+ * shader samples the glyph's coverage at the shadow offset and on a ring
+ * around the pixel and composites shadow and outline; then a fill quad per
+ * glyph.  All backgrounds of a string come before its fills, so no outline
+ * or shadow covers a neighbouring glyph's fill, and the list still goes out
+ * in a single draw call.  Each vertex carries its glyph's atlas rectangle
+ * so samples never leak into the neighbouring glyphs of the atlas.
+ */
+
+#define MAX_TEXT_STYLES 16
+
+typedef struct
+{
+    float FillR, FillG, FillB;          /* 0-255, any negative selects the rainbow mode */
+    float OutlineWidth;                 /* Pixels, 0 disables the outline */
+    float OutlineR, OutlineG, OutlineB; /* 0-255 */
+    float ShadowX, ShadowY;             /* Pixels, y down */
+    float ShadowR, ShadowG, ShadowB;    /* 0-255 */
+    float ShadowA;                      /* 0-1, 0 disables the shadow */
+} TextStyle;
+
+/* Vertex of a styled glyph quad */
+typedef struct
+{
+    float X, Y;
+    float U, V;
+    float R, G, B;          /* Fill color */
+    float U0, V0, U1, V1;   /* Atlas rectangle of the glyph bitmap */
+    float Style;            /* Index into the style table */
+    float Layer;            /* 0 = shadow and outline, 1 = fill */
+} StyledVertex;
+
+typedef struct
+{
+    StyledVertex *Vertices;
+    int Count;
+    int Capacity;
+} StyledDrawList;
+
+void styledDrawListInit(StyledDrawList *list);
+void styledDrawListFree(StyledDrawList *list);
+void styledDrawListClear(StyledDrawList *list);
+
+/*
+ * Append a UTF-8 string drawn with styles[styleIndex], baseline at y.
+ * The same style table must be handed to the renderer when submitting.
+ */
+float layoutStyledText(StyledDrawList *list, const GlyphAtlas *atlas, const char *text,
+                       float x, float y, float scale,
+                       const TextStyle *style, int styleIndex);
+
+#endif /* TEXT_STYLE_H */
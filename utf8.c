@@ -0,0 +1,51 @@
+#include "utf8.h"
+
+#define UTF8_REPLACEMENT 0xFFFD
+
+/* 从 UTF-8 编码的字符串中提取 Unicode 码点 */
+unsigned int codepoint_from_utf8(const char **text)
+{
+    unsigned int codepoint = 0;
+    const unsigned char *str = (const unsigned char *)(*text);
+    int length;
+
+    if (str[0] < 0x80) // 单字节 ASCII
+    {
+        *text += 1;
+        return str[0];
+    }
+    else if ((str[0] & 0xE0) == 0xC0) // 双字节
+    {
+        codepoint = str[0] & 0x1F;
+        length = 2;
+    }
+    else if ((str[0] & 0xF0) == 0xE0) // 三字节 (中文常见)
+    {
+        codepoint = str[0] & 0x0F;
+        length = 3;
+    }
+    else if ((str[0] & 0xF8) == 0xF0) // 四字节
+    {
+        codepoint = str[0] & 0x07;
+        length = 4;
+    }
+    else // 孤立的后续字节或非法首字节
+    {
+        *text += 1;
+        return UTF8_REPLACEMENT;
+    }
+
+    /* 后续字节必须是 10xxxxxx，遇到字符串结尾也会在这里停下 */
+    for (int i = 1; i < length; i++)
+    {
+        if ((str[i] & 0xC0) != 0x80)
+        {
+            *text += 1;
+            return UTF8_REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (str[i] & 0x3F);
+    }
+
+    *text += length;
+    return codepoint;
+}
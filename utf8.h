@@ -0,0 +1,10 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+/*
+ * 从 UTF-8 编码的字符串中提取 Unicode 码点，并把 *text 移到下一个字符。
+ * 非法或被截断的序列返回 U+FFFD，并且只前进一个字节，保证循环总能结束。
+ */
+unsigned int codepoint_from_utf8(const char **text);
+
+#endif /* UTF8_H */